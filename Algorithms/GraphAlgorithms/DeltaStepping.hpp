@@ -0,0 +1,28 @@
+// Created by Aaron H 5/28/24
+#ifndef DELTASTEPPING_HPP
+#define DELTASTEPPING_HPP
+#include "ShortestPaths.hpp"
+#include "../Parallel/ParallelFor.hpp"
+namespace GraphAlgorithms {
+
+    struct DeltaSteppingOptions {
+        unsigned threads = Parallel::defaultThreadCount();
+        // Bucket width. Edges up to delta are light and relaxed repeatedly inside a bucket, heavier ones once per
+        // bucket. Small values approach Dijkstra, large ones Bellman-Ford. 0 picks max weight / average out-degree.
+        // Values below max weight / (vertices per thread) are raised to it, which bounds the number of buckets.
+        double delta = 0.0;
+    };
+
+    // Meyer and Sanders' delta-stepping single-source shortest paths. Vertices sit in buckets of width delta by
+    // tentative distance; the lowest bucket is emptied in phases that relax its light edges in parallel, then the heavy
+    // edges of everything it settled go out once. Every vertex has an owner thread: relaxations are generated in
+    // parallel, routed to the target's owner and applied there without atomics, so parents always match distances.
+    // Buckets are reused cyclically, so memory grows with max weight / delta, not with the longest distance.
+    // Weights must be arithmetic and non-negative.
+    template <typename VerticeType, typename EdgeType>
+    ShortestPathTree<EdgeType> deltaStepping(const CSRGraph<VerticeType, EdgeType>& graph, const VerticeType& source,
+                                             const DeltaSteppingOptions& options = DeltaSteppingOptions());
+
+}  // namespace GraphAlgorithms
+#include "DeltaStepping.tpp"
+#endif
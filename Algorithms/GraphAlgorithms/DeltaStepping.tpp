@@ -0,0 +1,156 @@
+#include "DeltaStepping.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace GraphAlgorithms {
+
+    template <typename VerticeType, typename EdgeType>
+    ShortestPathTree<EdgeType> deltaStepping(const CSRGraph<VerticeType, EdgeType>& graph, const VerticeType& source,
+                                             const DeltaSteppingOptions& options) {
+        static_assert(std::is_arithmetic<EdgeType>::value, "Delta-stepping buckets arithmetic weights");
+        using VertexId = std::uint32_t;
+        using Tree = ShortestPathTree<EdgeType>;
+        constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+        constexpr std::size_t grain = 256;
+        struct Request {
+            VertexId target;
+            VertexId parent;
+            EdgeType distance;
+        };
+
+        if (graph.hasNegativeWeights()) {
+            throw std::runtime_error("Delta-stepping requires non-negative edge weights");
+        }
+        const VertexId sourceId = graph.idOf(source);
+        const std::size_t n = graph.numVertices();
+        const unsigned threads = std::max(options.threads, 1u);
+
+        EdgeType maxWeight = EdgeType(0);
+        for (const EdgeType& weight : graph.edgeWeights()) {
+            maxWeight = std::max(maxWeight, weight);
+        }
+        double delta = options.delta;
+        if (delta <= 0.0) {
+            delta = static_cast<double>(maxWeight) * n / std::max<std::size_t>(graph.numEdges(), 1);
+        }
+        if (std::is_integral<EdgeType>::value) {
+            delta = std::max(delta, 1.0);
+        } else if (delta <= 0.0) {
+            delta = 1.0;
+        }
+        // Every thread keeps max weight / delta buckets, so a tiny delta would allocate billions of them. Capping that
+        // at the vertices a thread owns keeps the bucket lists within the size of the graph; delta only tunes speed.
+        const double ownedVertices = static_cast<double>(std::max<std::size_t>(n / threads, 1));
+        delta = std::max(delta, static_cast<double>(maxWeight) / ownedVertices);
+        // Live tentative distances never span more than max weight past the current bucket
+        const std::size_t slots = static_cast<std::size_t>(static_cast<double>(maxWeight) / delta) + 2;
+        auto bucketOf = [delta](EdgeType distance) { return static_cast<std::size_t>(static_cast<double>(distance) / delta); };
+        auto ownerOf = [threads](VertexId vertex) { return vertex % threads; };
+
+        Tree tree;
+        tree.distance.assign(n, std::numeric_limits<EdgeType>::max());
+        tree.parent.assign(n, Tree::unreached);
+        // Absolute bucket each vertex is filed under, none once it leaves; older entries in the lists are stale
+        std::vector<std::size_t> filedUnder(n, none);
+        std::vector<unsigned char> removed(n, 0);
+        std::vector<std::vector<std::vector<VertexId>>> buckets(threads, std::vector<std::vector<VertexId>>(slots));
+        std::vector<std::size_t> live(threads, 0);
+        std::vector<std::vector<std::vector<Request>>> requests(threads, std::vector<std::vector<Request>>(threads));
+        std::vector<VertexId> frontier;
+        std::vector<VertexId> settled;
+
+        tree.distance[sourceId] = EdgeType(0);
+        tree.parent[sourceId] = sourceId;
+        filedUnder[sourceId] = 0;
+        buckets[ownerOf(sourceId)][0].push_back(sourceId);
+        live[ownerOf(sourceId)] = 1;
+
+        auto generate = [&](const std::vector<VertexId>& vertices, bool light) {
+            Parallel::parallelFor(0, vertices.size(), grain, threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+                auto& outgoing = requests[thread];
+                for (std::size_t index = begin; index < end; ++index) {
+                    const VertexId vertex = vertices[index];
+                    const EdgeType base = tree.distance[vertex];
+                    auto weight = graph.weightsBegin(vertex);
+                    for (auto target = graph.neighborsBegin(vertex); target != graph.neighborsEnd(vertex); ++target, ++weight) {
+                        if ((static_cast<double>(*weight) <= delta) == light) {
+                            outgoing[ownerOf(*target)].push_back(Request{*target, vertex, static_cast<EdgeType>(base + *weight)});
+                        }
+                    }
+                }
+            });
+        };
+        // Each owner drains the requests addressed to it, in producer order. Phases from a small frontier stay on the
+        // calling thread, as parallelFor already does for the generating side.
+        auto apply = [&](std::size_t frontierSize) {
+            const unsigned workers = frontierSize < grain ? 1 : threads;
+            Parallel::parallelFor(0, threads, 1, workers, [&](unsigned, std::size_t ownerBegin, std::size_t ownerEnd) {
+                for (std::size_t owner = ownerBegin; owner < ownerEnd; ++owner) {
+                    for (unsigned producer = 0; producer < threads; ++producer) {
+                        for (const Request& request : requests[producer][owner]) {
+                            if (!(request.distance < tree.distance[request.target])) {
+                                continue;
+                            }
+                            tree.distance[request.target] = request.distance;
+                            tree.parent[request.target] = request.parent;
+                            const std::size_t bucket = bucketOf(request.distance);
+                            if (filedUnder[request.target] != bucket) {
+                                live[owner] += filedUnder[request.target] == none;
+                                filedUnder[request.target] = bucket;
+                                buckets[owner][bucket % slots].push_back(request.target);
+                            }
+                        }
+                        requests[producer][owner].clear();
+                    }
+                }
+            });
+        };
+
+        for (std::size_t current = 0; ; ++current) {
+            std::size_t remaining = 0;
+            for (std::size_t count : live) {
+                remaining += count;
+            }
+            if (remaining == 0) {
+                break;
+            }
+            const std::size_t slot = current % slots;
+            settled.clear();
+            while (true) {
+                // Take the bucket's valid entries; a light relaxation may refill it for another phase
+                frontier.clear();
+                for (unsigned owner = 0; owner < threads; ++owner) {
+                    auto& entries = buckets[owner][slot];
+                    for (VertexId vertex : entries) {
+                        if (filedUnder[vertex] != current) {
+                            continue;
+                        }
+                        filedUnder[vertex] = none;
+                        --live[owner];
+                        frontier.push_back(vertex);
+                        if (!removed[vertex]) {
+                            removed[vertex] = 1;
+                            settled.push_back(vertex);
+                        }
+                    }
+                    entries.clear();
+                }
+                if (frontier.empty()) {
+                    break;
+                }
+                generate(frontier, true);
+                apply(frontier.size());
+            }
+            for (VertexId vertex : settled) {
+                removed[vertex] = 0;
+            }
+            if (!settled.empty()) {
+                generate(settled, false);
+                apply(settled.size());
+            }
+        }
+        return tree;
+    }
+
+}  // namespace GraphAlgorithms
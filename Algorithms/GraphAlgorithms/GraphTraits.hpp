@@ -0,0 +1,87 @@
+// Created by Aaron H 5/28/24
+#ifndef GRAPHTRAITS_HPP
+#define GRAPHTRAITS_HPP
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+namespace GraphAlgorithms {
+
+    // Vertex type of any graph with the id-level interface (DerivedGraph, CSRGraph, MappedCSRGraph)
+    template <typename GraphType>
+    using VertexOf = std::decay_t<decltype(std::declval<const GraphType&>().vertexOf(0))>;
+
+    // The graph interface is a compile-time contract rather than a base class: algorithms are templates over the
+    // concrete backend and check it against these traits, so any storage that provides the members works with no
+    // dispatch at run time.
+
+    // Read-only id-level access, all a traversal needs: ids below idBound(), the live ones per containsId(), and
+    // out-neighbors by position
+    template <typename GraphType, typename = void>
+    struct IsIdGraph : std::false_type {};
+
+    template <typename GraphType>
+    struct IsIdGraph<GraphType, std::void_t<
+            decltype(std::declval<const GraphType&>().idBound()),
+            decltype(std::declval<const GraphType&>().containsId(std::uint32_t{})),
+            decltype(std::declval<const GraphType&>().outDegree(std::uint32_t{})),
+            decltype(std::declval<const GraphType&>().neighborAt(std::uint32_t{}, std::size_t{})),
+            decltype(std::declval<const GraphType&>().idOf(std::declval<const VertexOf<GraphType>&>()))>> : std::true_type {};
+
+    // Id-level access plus edge weights of type GraphType::Weight
+    template <typename GraphType, typename = void>
+    struct IsWeightedIdGraph : std::false_type {};
+
+    template <typename GraphType>
+    struct IsWeightedIdGraph<GraphType, std::void_t<typename GraphType::Weight>> : IsIdGraph<GraphType> {};
+
+    // Vertex-level mutation in the shape of DerivedGraph's
+    template <typename GraphType, typename = void>
+    struct IsMutableGraph : std::false_type {};
+
+    template <typename GraphType>
+    struct IsMutableGraph<GraphType, std::void_t<
+            decltype(std::declval<GraphType&>().addVertex(std::declval<const VertexOf<GraphType>&>())),
+            decltype(std::declval<GraphType&>().removeVertex(std::declval<const VertexOf<GraphType>&>())),
+            decltype(std::declval<GraphType&>().addEdge(std::declval<const VertexOf<GraphType>&>(), std::declval<const VertexOf<GraphType>&>(),
+                                                        std::declval<const typename GraphType::Weight&>(), true)),
+            decltype(std::declval<GraphType&>().removeEdge(std::declval<const VertexOf<GraphType>&>(), std::declval<const VertexOf<GraphType>&>())),
+            decltype(std::declval<const GraphType&>().hasEdge(std::declval<const VertexOf<GraphType>&>(), std::declval<const VertexOf<GraphType>&>()))>>
+            : IsWeightedIdGraph<GraphType> {};
+
+    // Storage layouts algorithms may special-case: per-vertex (id, weight) lists, or compressed rows
+    template <typename GraphType, typename = void>
+    struct HasAdjacencyLists : std::false_type {};
+
+    template <typename GraphType>
+    struct HasAdjacencyLists<GraphType, std::void_t<decltype(std::declval<const GraphType&>().adjacentIds(std::uint32_t{}))>> : std::true_type {};
+
+    template <typename GraphType, typename = void>
+    struct HasCompressedRows : std::false_type {};
+
+    template <typename GraphType>
+    struct HasCompressedRows<GraphType, std::void_t<decltype(std::declval<const GraphType&>().neighborsBegin(std::uint32_t{})),
+                                                    decltype(std::declval<const GraphType&>().weightsBegin(std::uint32_t{}))>> : std::true_type {};
+
+    // Compressed rows of the transpose as well (sources of each vertex's in-edges), for pull-style algorithms
+    template <typename GraphType, typename = void>
+    struct HasInEdgeRows : std::false_type {};
+
+    template <typename GraphType>
+    struct HasInEdgeRows<GraphType, std::void_t<decltype(std::declval<const GraphType&>().hasInEdges()),
+                                                decltype(std::declval<const GraphType&>().inNeighborsBegin(std::uint32_t{})),
+                                                decltype(std::declval<const GraphType&>().inNeighborsEnd(std::uint32_t{}))>> : std::true_type {};
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+    template <typename GraphType>
+    concept IdGraph = IsIdGraph<GraphType>::value;
+
+    template <typename GraphType>
+    concept WeightedIdGraph = IsWeightedIdGraph<GraphType>::value;
+
+    template <typename GraphType>
+    concept MutableGraph = IsMutableGraph<GraphType>::value;
+#endif
+
+}  // namespace GraphAlgorithms
+#endif
@@ -1,14 +1,23 @@
 // Created by Aaron H 5/28/24
 #ifndef ISCYCLIC_HPP
 #define ISCYCLIC_HPP
+#include "GraphTraits.hpp"
 #include "../../Structures/ADT/Graph.hpp"
+#include <string>
 namespace GraphAlgorithms {
 
-    template <typename VerticeType, typename EdgeType>
-    bool isCyclic(DerivedGraph<VerticeType, EdgeType>& graph);
+    // Both work on any graph with the id-level interface (see GraphTraits.hpp)
+    template <typename GraphType>
+    bool isCyclic(const GraphType& graph);
 
-    template <typename VerticeType, typename EdgeType>
-    bool isCyclicUtil(DerivedGraph<VerticeType, EdgeType>& graph, const VerticeType &vertex, std::unordered_map<VerticeType, bool> &visited, std::unordered_map<VerticeType, bool> &recursionStack);
+    // Returns the vertices of one directed cycle in path order (the last one leads back to the first), or an empty
+    // vector when the graph is acyclic
+    template <typename GraphType>
+    std::vector<VertexOf<GraphType>> findCycle(const GraphType& graph);
+
+    // Formats a cycle as "a -> b -> a", or just its length for vertex types that cannot be streamed
+    template <typename VerticeType>
+    std::string describeCycle(const std::vector<VerticeType>& cycle);
 
 }  // namespace GraphAlgorithms
 #include "IsCyclic.tpp"
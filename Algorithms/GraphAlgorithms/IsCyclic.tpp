@@ -1,44 +1,79 @@
 // IsCyclic.tpp
-#include "../Searching/DFS/DFS.hpp"
+#include "../Searching/DFS/DFSEngine.hpp"
+#include <sstream>
+#include <type_traits>
 
 namespace GraphAlgorithms {
 
-    template <typename VerticeType, typename EdgeType>
-    bool isCyclicUtil(DerivedGraph<VerticeType, EdgeType>& graph, const VerticeType &vertex,
-                      std::unordered_map<VerticeType, bool> &visited,
-                      std::unordered_map<VerticeType, bool> &recursionStack) {
-        if (visited[vertex]) {
-            return recursionStack[vertex]; // If visited and in recursion stack, it's a cycle
-        }
+    // A directed graph has a cycle exactly when a depth-first search meets a back edge
+    struct BackEdgeDetector : Searching::DFSVisitor {
+        bool found = false;
+        std::size_t discovered = 0;
+        void discoverVertex(std::uint32_t) { ++discovered; }
+        void backEdge(std::uint32_t, std::uint32_t) { found = true; }
+        [[nodiscard]] bool stop() const { return found; }
+    };
 
-        visited[vertex] = true;
-        recursionStack[vertex] = true;
+    template <typename GraphType>
+    bool isCyclic(const GraphType& graph) {
+        GRAPH_METRICS_SCOPE(IsCyclic);
+        Searching::DFSEngine<GraphType> engine(graph);
+        BackEdgeDetector detector;
+        engine.visitAll(detector);
+        GRAPH_METRICS_WORK(VerticesVisited, detector.discovered);
+        return detector.found;
+    }
 
-        for (auto iter = graph.adjacentBegin(vertex); iter != graph.adjacentEnd(vertex); ++iter) {
-            auto& adjacentVertex = iter->first;  // Assuming *iter gives std::pair
-            if (isCyclicUtil(graph, adjacentVertex, visited, recursionStack)) {
-                return true;
-            }
+    // Remembers DFS tree parents so the back edge that closes a cycle can be walked back into a path
+    struct CycleRecorder : Searching::DFSVisitor {
+        std::vector<std::uint32_t> parent;
+        std::uint32_t cycleStart = 0, cycleEnd = 0;
+        bool found = false;
+        explicit CycleRecorder(std::uint32_t bound) : parent(bound) {}
+        void treeEdge(std::uint32_t from, std::uint32_t to) { parent[to] = from; }
+        void backEdge(std::uint32_t from, std::uint32_t to) {
+            cycleStart = to;
+            cycleEnd = from;
+            found = true;
         }
+        [[nodiscard]] bool stop() const { return found; }
+    };
 
-        recursionStack[vertex] = false;  // Remove the vertex from recursion stack
-        return false;
+    template <typename GraphType>
+    std::vector<VertexOf<GraphType>> findCycle(const GraphType& graph) {
+        Searching::DFSEngine<GraphType> engine(graph);
+        CycleRecorder recorder(graph.idBound());
+        std::vector<VertexOf<GraphType>> cycle;
+        if (engine.visitAll(recorder)) {
+            return cycle;
+        }
+        for (std::uint32_t vertex = recorder.cycleEnd; vertex != recorder.cycleStart; vertex = recorder.parent[vertex]) {
+            cycle.push_back(graph.vertexOf(vertex));
+        }
+        cycle.push_back(graph.vertexOf(recorder.cycleStart));
+        std::reverse(cycle.begin(), cycle.end());
+        return cycle;
     }
 
-    template <typename VerticeType, typename EdgeType>
-    bool isCyclic(DerivedGraph<VerticeType, EdgeType>& graph) {
-        std::unordered_map<VerticeType, bool> visited;
-        std::unordered_map<VerticeType, bool> recursionStack;
-
-        const auto& vertices = graph.getVertices();  // Optimize to avoid repeated calls
-        for (const auto& vertex : vertices) {
-            if (!visited[vertex]) {  // Only process unvisited nodes to avoid redundant work
-                if (isCyclicUtil(graph, vertex, visited, recursionStack)) {
-                    return true;
-                }
+    template <typename T, typename = void>
+    struct IsStreamable : std::false_type {};
+
+    template <typename T>
+    struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>> : std::true_type {};
+
+    template <typename VerticeType>
+    std::string describeCycle(const std::vector<VerticeType>& cycle) {
+        if constexpr (IsStreamable<VerticeType>::value) {
+            std::ostringstream out;
+            for (const auto& vertex : cycle) {
+                out << vertex << " -> ";
             }
+            if (!cycle.empty()) {
+                out << cycle.front();
+            }
+            return out.str();
+        } else {
+            return std::to_string(cycle.size()) + "-vertex cycle";
         }
-
-        return false;
     }
 }  // namespace GraphAlgorithms
@@ -0,0 +1,46 @@
+// Created by Aaron H 5/28/24
+#ifndef PAGERANK_HPP
+#define PAGERANK_HPP
+#include "Spmv.hpp"
+#include <cstddef>
+#include <vector>
+namespace GraphAlgorithms {
+
+    struct PageRankOptions {
+        double damping = 0.85;           // Probability of following an edge rather than jumping to a random vertex
+        double tolerance = 1e-6;         // Stop once the scores move less than this in L1 distance
+        std::size_t maxIterations = 100;
+        unsigned threads = Parallel::defaultThreadCount();
+    };
+
+    struct KatzOptions {
+        double alpha = 0.1;              // Attenuation per hop; must stay below 1 / (largest eigenvalue) to converge
+        double beta = 1.0;               // Score every vertex starts with
+        double tolerance = 1e-6;
+        std::size_t maxIterations = 100;
+        unsigned threads = Parallel::defaultThreadCount();
+    };
+
+    // Scores per id of the graph, as float or double
+    template <typename Scalar>
+    struct IterativeScores {
+        std::vector<Scalar> scores;
+        std::size_t iterations = 0;
+        double residual = 0.0;           // L1 change of the last iteration
+        bool converged = false;
+    };
+
+    // Pull-based power iteration: each sweep a vertex sums the rank shares of its in-neighbors through spmv() over the
+    // transpose, so every score has one writer and no atomics are needed. Rank held by vertices without out-edges is
+    // spread evenly over all vertices. Scores sum to 1. Needs a CSR graph with in-edges, e.g. DerivedGraph::freeze(true)
+    // or a graph file written with in-edges; throws std::runtime_error otherwise.
+    template <typename Scalar = double, typename GraphType>
+    IterativeScores<Scalar> pageRank(const GraphType& graph, const PageRankOptions& options = PageRankOptions());
+
+    // Katz centrality, x = alpha A^T x + beta, by the same pull iteration
+    template <typename Scalar = double, typename GraphType>
+    IterativeScores<Scalar> katzCentrality(const GraphType& graph, const KatzOptions& options = KatzOptions());
+
+}  // namespace GraphAlgorithms
+#include "PageRank.tpp"
+#endif
@@ -0,0 +1,110 @@
+// PageRank.tpp
+#include "PageRank.hpp"
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace GraphAlgorithms {
+
+    namespace PageRankDetail {
+
+        template <typename Scalar, typename GraphType>
+        void requirePullGraph(const GraphType& graph) {
+            static_assert(std::is_floating_point<Scalar>::value, "Scores are float or double");
+            static_assert(HasCompressedRows<GraphType>::value && HasInEdgeRows<GraphType>::value,
+                          "Pull iterations need a CSR graph with in-edge rows");
+            if (!graph.hasInEdges()) {
+                throw std::runtime_error("The graph was frozen without in-edges");
+            }
+        }
+
+    }  // namespace PageRankDetail
+
+    template <typename Scalar, typename GraphType>
+    IterativeScores<Scalar> pageRank(const GraphType& graph, const PageRankOptions& options) {
+        PageRankDetail::requirePullGraph<Scalar>(graph);
+        if (options.damping < 0.0 || options.damping >= 1.0) {
+            throw std::runtime_error("PageRank damping must lie in [0, 1)");
+        }
+        const std::uint32_t n = graph.idBound();
+        const unsigned threads = std::max(options.threads, 1u);
+        IterativeScores<Scalar> result;
+        if (n == 0) {
+            result.converged = true;
+            return result;
+        }
+
+        // Separate arrays per quantity, so every sweep streams through contiguous scores
+        std::vector<Scalar> inverseOutDegree(n);
+        for (std::uint32_t id = 0; id < n; ++id) {
+            const std::size_t degree = graph.outDegree(id);
+            inverseOutDegree[id] = degree == 0 ? Scalar(0) : Scalar(1) / static_cast<Scalar>(degree);
+        }
+        std::vector<Scalar> rank(n, Scalar(1) / static_cast<Scalar>(n));
+        std::vector<Scalar> next(n);
+        std::vector<Scalar> share(n);
+        std::vector<double> dangling(threads);
+        const InEdgeRows<GraphType> transpose{graph};
+        const auto damping = static_cast<Scalar>(options.damping);
+
+        while (result.iterations < options.maxIterations) {
+            std::fill(dangling.begin(), dangling.end(), 0.0);
+            Parallel::parallelFor(0, n, SpmvDetail::rowGrain, threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+                double mass = 0.0;
+                for (std::size_t id = begin; id < end; ++id) {
+                    share[id] = rank[id] * inverseOutDegree[id];
+                    mass += inverseOutDegree[id] == Scalar(0) ? static_cast<double>(rank[id]) : 0.0;
+                }
+                dangling[thread] += mass;
+            });
+            double danglingMass = 0.0;
+            for (double mass : dangling) {
+                danglingMass += mass;
+            }
+            const auto base = static_cast<Scalar>((1.0 - options.damping + options.damping * danglingMass) / n);
+            result.residual = spmv(transpose, share.data(), next.data(),
+                                   [base, damping](std::uint32_t, Scalar pulled) { return base + damping * pulled; },
+                                   rank.data(), threads);
+            std::swap(rank, next);
+            ++result.iterations;
+            if (result.residual < options.tolerance) {
+                result.converged = true;
+                break;
+            }
+        }
+        result.scores = std::move(rank);
+        return result;
+    }
+
+    template <typename Scalar, typename GraphType>
+    IterativeScores<Scalar> katzCentrality(const GraphType& graph, const KatzOptions& options) {
+        PageRankDetail::requirePullGraph<Scalar>(graph);
+        const std::uint32_t n = graph.idBound();
+        const unsigned threads = std::max(options.threads, 1u);
+        IterativeScores<Scalar> result;
+        if (n == 0) {
+            result.converged = true;
+            return result;
+        }
+
+        const auto alpha = static_cast<Scalar>(options.alpha);
+        const auto beta = static_cast<Scalar>(options.beta);
+        std::vector<Scalar> score(n, beta);
+        std::vector<Scalar> next(n);
+        const InEdgeRows<GraphType> transpose{graph};
+        while (result.iterations < options.maxIterations) {
+            result.residual = spmv(transpose, score.data(), next.data(),
+                                   [alpha, beta](std::uint32_t, Scalar pulled) { return alpha * pulled + beta; },
+                                   score.data(), threads);
+            std::swap(score, next);
+            ++result.iterations;
+            if (result.residual < options.tolerance) {
+                result.converged = true;
+                break;
+            }
+        }
+        result.scores = std::move(score);
+        return result;
+    }
+
+}  // namespace GraphAlgorithms
@@ -0,0 +1,188 @@
+// Created by Aaron H 5/28/24
+#ifndef SETINTERSECTION_HPP
+#define SETINTERSECTION_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+namespace GraphAlgorithms {
+
+    // Intersection of two ascending, duplicate-free id lists. visit(id) runs for every common id, in ascending order,
+    // and the number of common ids is returned; a visitor that does nothing compiles down to a pure count. The kernel
+    // is picked at compile time: AVX2 compares blocks of 8 against 8, SSE2 blocks of 4 against 4, and without either
+    // a branch-free scalar merge runs. When one list is much longer, the short one gallops through it instead.
+    template <typename Visit>
+    std::size_t intersectSorted(const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, Visit&& visit);
+
+    inline std::size_t intersectionSize(const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize) {
+        return intersectSorted(a, aSize, b, bSize, [](std::uint32_t) {});
+    }
+
+    namespace IntersectionDetail {
+
+        // Galloping wins once the longer list is this many times the shorter one
+        constexpr std::size_t gallopRatio = 32;
+
+        inline unsigned lowestBit(unsigned mask) {
+#if defined(__GNUC__)
+            return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+            unsigned bit = 0;
+            while ((mask & 1u) == 0) {
+                mask >>= 1;
+                ++bit;
+            }
+            return bit;
+#endif
+        }
+
+        inline std::size_t bitCount(unsigned mask) {
+#if defined(__GNUC__)
+            return static_cast<std::size_t>(__builtin_popcount(mask));
+#else
+            std::size_t count = 0;
+            for (; mask != 0; mask &= mask - 1) {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        // Reports a[offset + bit] for every set bit of mask
+        template <typename Visit>
+        void visitMask(const std::uint32_t* a, unsigned mask, Visit& visit) {
+            for (; mask != 0; mask &= mask - 1) {
+                visit(a[lowestBit(mask)]);
+            }
+        }
+
+        // Merge that advances by comparison results instead of branching on them
+        template <typename Visit>
+        std::size_t scalarIntersect(const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, Visit& visit) {
+            std::size_t i = 0, j = 0, count = 0;
+            while (i < aSize && j < bSize) {
+                const std::uint32_t x = a[i];
+                const std::uint32_t y = b[j];
+                if (x == y) {
+                    visit(x);
+                    ++count;
+                }
+                i += x <= y;
+                j += y <= x;
+            }
+            return count;
+        }
+
+        // Each element of the short list is found by exponential then binary search from the last match position
+        template <typename Visit>
+        std::size_t gallopIntersect(const std::uint32_t* small, std::size_t smallSize, const std::uint32_t* large, std::size_t largeSize,
+                                    Visit& visit) {
+            std::size_t count = 0;
+            std::size_t low = 0;
+            for (std::size_t i = 0; i < smallSize && low < largeSize; ++i) {
+                const std::uint32_t x = small[i];
+                std::size_t step = 1;
+                std::size_t high = low;
+                while (high < largeSize && large[high] < x) {
+                    low = high + 1;
+                    high += step;
+                    step *= 2;
+                }
+                low = static_cast<std::size_t>(std::lower_bound(large + low, large + std::min(high + 1, largeSize), x) - large);
+                if (low < largeSize && large[low] == x) {
+                    visit(x);
+                    ++count;
+                    ++low;
+                }
+            }
+            return count;
+        }
+
+#if defined(__SSE2__)
+        // Every 4-element block of a meets the 4 rotations of the current block of b; the block with the smaller last
+        // element moves on (both on a tie), so each pair of overlapping blocks is compared exactly once
+        template <typename Visit>
+        std::size_t sseIntersect(const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, Visit& visit) {
+            std::size_t i = 0, j = 0, count = 0;
+            const std::size_t aBlocks = aSize & ~std::size_t{3};
+            const std::size_t bBlocks = bSize & ~std::size_t{3};
+            while (i < aBlocks && j < bBlocks) {
+                const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+                const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+                const __m128i equal = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+                        _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                                     _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+                const auto mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+                count += bitCount(mask);
+                visitMask(a + i, mask, visit);
+                const std::uint32_t aLast = a[i + 3];
+                const std::uint32_t bLast = b[j + 3];
+                i += aLast <= bLast ? 4 : 0;
+                j += bLast <= aLast ? 4 : 0;
+            }
+            return count + scalarIntersect(a + i, aSize - i, b + j, bSize - j, visit);
+        }
+#endif
+
+#if defined(__AVX2__)
+        // sseIntersect with 8-element blocks: 8 lane rotations of the block of b
+        template <typename Visit>
+        std::size_t avx2Intersect(const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, Visit& visit) {
+            std::size_t i = 0, j = 0, count = 0;
+            const std::size_t aBlocks = aSize & ~std::size_t{7};
+            const std::size_t bBlocks = bSize & ~std::size_t{7};
+            const __m256i rotate = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+            while (i < aBlocks && j < bBlocks) {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+                __m256i equal = _mm256_cmpeq_epi32(va, vb);
+                for (int rotation = 1; rotation < 8; ++rotation) {
+                    vb = _mm256_permutevar8x32_epi32(vb, rotate);
+                    equal = _mm256_or_si256(equal, _mm256_cmpeq_epi32(va, vb));
+                }
+                const auto mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+                count += bitCount(mask);
+                visitMask(a + i, mask, visit);
+                const std::uint32_t aLast = a[i + 7];
+                const std::uint32_t bLast = b[j + 7];
+                i += aLast <= bLast ? 8 : 0;
+                j += bLast <= aLast ? 8 : 0;
+            }
+#if defined(__SSE2__)
+            return count + sseIntersect(a + i, aSize - i, b + j, bSize - j, visit);
+#else
+            return count + scalarIntersect(a + i, aSize - i, b + j, bSize - j, visit);
+#endif
+        }
+#endif
+
+    }  // namespace IntersectionDetail
+
+    template <typename Visit>
+    std::size_t intersectSorted(const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, Visit&& visit) {
+        if (aSize == 0 || bSize == 0 || a[aSize - 1] < b[0] || b[bSize - 1] < a[0]) {
+            return 0;
+        }
+        if (aSize * IntersectionDetail::gallopRatio < bSize) {
+            return IntersectionDetail::gallopIntersect(a, aSize, b, bSize, visit);
+        }
+        if (bSize * IntersectionDetail::gallopRatio < aSize) {
+            return IntersectionDetail::gallopIntersect(b, bSize, a, aSize, visit);
+        }
+#if defined(__AVX2__)
+        return IntersectionDetail::avx2Intersect(a, aSize, b, bSize, visit);
+#elif defined(__SSE2__)
+        return IntersectionDetail::sseIntersect(a, aSize, b, bSize, visit);
+#else
+        return IntersectionDetail::scalarIntersect(a, aSize, b, bSize, visit);
+#endif
+    }
+
+}  // namespace GraphAlgorithms
+#endif
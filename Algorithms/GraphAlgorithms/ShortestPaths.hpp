@@ -0,0 +1,81 @@
+// Created by Aaron H 5/28/24
+#ifndef SHORTESTPATHS_HPP
+#define SHORTESTPATHS_HPP
+#include "GraphTraits.hpp"
+#include "../../Structures/ADT/Graph.hpp"
+#include "../../Data-Structures/Queue/DaryHeap.hpp"
+#include "../../Data-Structures/Queue/PairingHeap.hpp"
+#include "../../Data-Structures/Queue/RadixHeap.hpp"
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+namespace GraphAlgorithms {
+
+    // Dijkstra's algorithm over vertex ids, on DerivedGraph or any CSR-layout graph (CSRGraph, MappedCSRGraph).
+    // Heap is a min-queue with the DaryHeap interface: DaryHeap, PairingHeap, or RadixHeap for integral weights.
+    // Negative weights are rejected at construction, in O(1) for DerivedGraph and CSRGraph and by one scan otherwise.
+    // Distances, parents and the queue are kept across runs and a run resets only what the previous one touched, so
+    // repeated point-to-point queries cost in proportion to the region they explore. The graph must not change while
+    // an engine is alive.
+    template <typename GraphType, template <typename> class Heap = DaryHeap>
+    class DijkstraEngine {
+        static_assert(IsWeightedIdGraph<GraphType>::value, "DijkstraEngine needs the id-level graph interface and a Weight type");
+    public:
+        using VertexId = std::uint32_t;
+        using Distance = typename GraphType::Weight;
+        static constexpr VertexId unreached = std::numeric_limits<VertexId>::max();
+
+        explicit DijkstraEngine(const GraphType& graph);
+
+        // Settles everything reachable from source
+        void run(VertexId source);
+        // Stops as soon as target is settled; returns whether it was reached
+        bool run(VertexId source, VertexId target);
+
+        // Distances and parents are final only for settled vertices. The source is its own parent.
+        [[nodiscard]] bool settled(VertexId vertex) const { return state[vertex] == Settled; }
+        Distance distance(VertexId vertex) const { return distances[vertex]; }
+        VertexId parent(VertexId vertex) const { return parents[vertex]; }
+        // Ids from the source to target, empty if target is not settled
+        std::vector<VertexId> pathTo(VertexId target) const;
+
+    private:
+        enum : unsigned char { Unseen, Queued, Settled };
+
+        const GraphType& graph;
+        std::vector<Distance> distances;
+        std::vector<VertexId> parents;
+        std::vector<unsigned char> state;
+        std::vector<VertexId> touched;
+        Heap<Distance> queue;
+
+        bool search(VertexId source, VertexId target);
+    };
+
+    // Per dense vertex id; unreached vertices keep parent unreached and the largest distance
+    template <typename Distance>
+    struct ShortestPathTree {
+        static constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+        std::vector<Distance> distance;
+        std::vector<std::uint32_t> parent;
+    };
+
+    template <typename VerticeType, typename Distance>
+    struct ShortestPath {
+        bool found = false;
+        Distance length{};
+        std::vector<VerticeType> vertices;  // From source to target
+    };
+
+    // One-off searches; keep a DijkstraEngine around for many queries on the same graph
+    template <template <typename> class Heap = DaryHeap, typename GraphType>
+    ShortestPathTree<typename GraphType::Weight> dijkstra(const GraphType& graph, const VertexOf<GraphType>& source);
+
+    template <template <typename> class Heap = DaryHeap, typename GraphType>
+    ShortestPath<VertexOf<GraphType>, typename GraphType::Weight> shortestPath(const GraphType& graph, const VertexOf<GraphType>& source,
+                                                                               const VertexOf<GraphType>& target);
+
+}  // namespace GraphAlgorithms
+#include "ShortestPaths.tpp"
+#endif
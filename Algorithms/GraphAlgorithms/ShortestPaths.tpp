@@ -0,0 +1,178 @@
+#include "ShortestPaths.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+namespace GraphAlgorithms {
+
+    namespace ShortestPathDetail {
+
+        // Walks the storage directly where the layout is known, through the id-level interface otherwise
+        template <typename GraphType, typename Visit>
+        void forEachOutEdge(const GraphType& graph, std::uint32_t vertex, Visit&& visit) {
+            if constexpr (HasAdjacencyLists<GraphType>::value) {
+                for (const auto& edge : graph.adjacentIds(vertex)) {
+                    visit(edge.first, edge.second);
+                }
+            } else {
+                static_assert(HasCompressedRows<GraphType>::value, "Shortest paths need adjacentIds() or neighborsBegin()/weightsBegin()");
+                auto weight = graph.weightsBegin(vertex);
+                for (auto target = graph.neighborsBegin(vertex); target != graph.neighborsEnd(vertex); ++target, ++weight) {
+                    visit(*target, *weight);
+                }
+            }
+        }
+
+        template <typename GraphType, typename = void>
+        struct TracksNegativeWeights : std::false_type {};
+
+        template <typename GraphType>
+        struct TracksNegativeWeights<GraphType, std::void_t<decltype(std::declval<const GraphType&>().hasNegativeWeights())>> : std::true_type {};
+
+        template <typename GraphType, typename = void>
+        struct KeepsStats : std::false_type {};
+
+        template <typename GraphType>
+        struct KeepsStats<GraphType, std::void_t<decltype(std::declval<const GraphType&>().stats().negativeWeightEdges)>> : std::true_type {};
+
+        // Answered from the graph's own bookkeeping when it keeps any, by a scan otherwise
+        template <typename GraphType>
+        bool hasNegativeWeights(const GraphType& graph) {
+            if constexpr (TracksNegativeWeights<GraphType>::value) {
+                return graph.hasNegativeWeights();
+            } else if constexpr (KeepsStats<GraphType>::value) {
+                return graph.stats().negativeWeightEdges != 0;
+            } else {
+                for (std::uint32_t vertex = 0; vertex < graph.idBound(); ++vertex) {
+                    bool negative = false;
+                    forEachOutEdge(graph, vertex, [&](std::uint32_t, const typename GraphType::Weight& weight) {
+                        negative = negative || isNegativeWeight(weight);
+                    });
+                    if (negative) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        }
+
+    }  // namespace ShortestPathDetail
+
+    template <typename GraphType, template <typename> class Heap>
+    DijkstraEngine<GraphType, Heap>::DijkstraEngine(const GraphType& graph)
+            : graph(graph), distances(graph.idBound()), parents(graph.idBound(), unreached), state(graph.idBound(), Unseen),
+              queue(graph.idBound()) {
+        if (ShortestPathDetail::hasNegativeWeights(graph)) {
+            throw std::runtime_error("Dijkstra's algorithm requires non-negative edge weights");
+        }
+    }
+
+    template <typename GraphType, template <typename> class Heap>
+    void DijkstraEngine<GraphType, Heap>::run(VertexId source) {
+        search(source, unreached);
+    }
+
+    template <typename GraphType, template <typename> class Heap>
+    bool DijkstraEngine<GraphType, Heap>::run(VertexId source, VertexId target) {
+        return search(source, target);
+    }
+
+    template <typename GraphType, template <typename> class Heap>
+    bool DijkstraEngine<GraphType, Heap>::search(VertexId source, VertexId target) {
+        if (!graph.containsId(source)) {
+            throw std::runtime_error("Vertex does not exist in the graph");
+        }
+        for (VertexId vertex : touched) {
+            parents[vertex] = unreached;
+            state[vertex] = Unseen;
+        }
+        touched.clear();
+        queue.clear();
+
+        distances[source] = Distance(0);
+        parents[source] = source;
+        state[source] = Queued;
+        touched.push_back(source);
+        queue.push(source, Distance(0));
+        while (!queue.empty()) {
+            auto [vertex, key] = queue.pop();
+            // Lazily updated heaps hand back superseded entries
+            if (state[vertex] == Settled || distances[vertex] < key) {
+                continue;
+            }
+            state[vertex] = Settled;
+            if (vertex == target) {
+                return true;
+            }
+            ShortestPathDetail::forEachOutEdge(graph, vertex, [&](VertexId next, const Distance& weight) {
+                if (state[next] == Settled) {
+                    return;
+                }
+                Distance candidate = key + weight;
+                if (state[next] == Unseen) {
+                    state[next] = Queued;
+                    touched.push_back(next);
+                    distances[next] = candidate;
+                    parents[next] = vertex;
+                    queue.push(next, candidate);
+                } else if (candidate < distances[next]) {
+                    distances[next] = candidate;
+                    parents[next] = vertex;
+                    queue.decrease(next, candidate);
+                }
+            });
+        }
+        return false;
+    }
+
+    template <typename GraphType, template <typename> class Heap>
+    std::vector<typename DijkstraEngine<GraphType, Heap>::VertexId> DijkstraEngine<GraphType, Heap>::pathTo(VertexId target) const {
+        std::vector<VertexId> path;
+        if (!settled(target)) {
+            return path;
+        }
+        for (VertexId vertex = target; ; vertex = parents[vertex]) {
+            path.push_back(vertex);
+            if (parents[vertex] == vertex) {
+                break;
+            }
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    template <template <typename> class Heap, typename GraphType>
+    ShortestPathTree<typename GraphType::Weight> dijkstra(const GraphType& graph, const VertexOf<GraphType>& source) {
+        using Distance = typename GraphType::Weight;
+        DijkstraEngine<GraphType, Heap> engine(graph);
+        engine.run(graph.idOf(source));
+        ShortestPathTree<Distance> tree;
+        tree.distance.assign(graph.idBound(), std::numeric_limits<Distance>::max());
+        tree.parent.assign(graph.idBound(), ShortestPathTree<Distance>::unreached);
+        for (std::uint32_t vertex = 0; vertex < graph.idBound(); ++vertex) {
+            if (engine.settled(vertex)) {
+                tree.distance[vertex] = engine.distance(vertex);
+                tree.parent[vertex] = engine.parent(vertex);
+            }
+        }
+        return tree;
+    }
+
+    template <template <typename> class Heap, typename GraphType>
+    ShortestPath<VertexOf<GraphType>, typename GraphType::Weight> shortestPath(const GraphType& graph, const VertexOf<GraphType>& source,
+                                                                               const VertexOf<GraphType>& target) {
+        DijkstraEngine<GraphType, Heap> engine(graph);
+        std::uint32_t targetId = graph.idOf(target);
+        ShortestPath<VertexOf<GraphType>, typename GraphType::Weight> path;
+        if (!engine.run(graph.idOf(source), targetId)) {
+            return path;
+        }
+        path.found = true;
+        path.length = engine.distance(targetId);
+        for (std::uint32_t vertex : engine.pathTo(targetId)) {
+            path.vertices.push_back(graph.vertexOf(vertex));
+        }
+        return path;
+    }
+
+}  // namespace GraphAlgorithms
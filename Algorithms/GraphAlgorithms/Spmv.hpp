@@ -0,0 +1,81 @@
+// Created by Aaron H 5/28/24
+#ifndef SPMV_HPP
+#define SPMV_HPP
+#include "GraphTraits.hpp"
+#include "../Parallel/ParallelFor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+namespace GraphAlgorithms {
+
+    // A graph's adjacency as a 0/1 sparse matrix in compressed rows. InEdgeRows lists the sources of each vertex's
+    // in-edges, so multiplying by it pulls values along edges (y = A^T x); OutEdgeRows lists the targets (y = A x).
+    template <typename GraphType>
+    struct InEdgeRows {
+        const GraphType& graph;
+        [[nodiscard]] std::uint32_t rows() const { return graph.idBound(); }
+        const std::uint32_t* rowBegin(std::uint32_t row) const { return graph.inNeighborsBegin(row); }
+        const std::uint32_t* rowEnd(std::uint32_t row) const { return graph.inNeighborsEnd(row); }
+    };
+
+    template <typename GraphType>
+    struct OutEdgeRows {
+        const GraphType& graph;
+        [[nodiscard]] std::uint32_t rows() const { return graph.idBound(); }
+        const std::uint32_t* rowBegin(std::uint32_t row) const { return graph.neighborsBegin(row); }
+        const std::uint32_t* rowEnd(std::uint32_t row) const { return graph.neighborsEnd(row); }
+    };
+
+    namespace SpmvDetail {
+
+        constexpr std::size_t rowGrain = 1024;  // Rows per dynamically claimed chunk
+
+        // Four independent partial sums, so the adds of a long row overlap instead of waiting on each other
+        template <typename Scalar>
+        Scalar gatherSum(const std::uint32_t* column, const std::uint32_t* end, const Scalar* x) {
+            Scalar sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+            for (; end - column >= 4; column += 4) {
+                sum0 += x[column[0]];
+                sum1 += x[column[1]];
+                sum2 += x[column[2]];
+                sum3 += x[column[3]];
+            }
+            for (; column != end; ++column) {
+                sum0 += x[*column];
+            }
+            return (sum0 + sum1) + (sum2 + sum3);
+        }
+
+    }  // namespace SpmvDetail
+
+    // One sweep of y[r] = finish(r, sum of x over row r) for every row of matrix, rows spread over threads. x and y
+    // must not overlap. When previous is given (the last iterate of y, which may be x for a square fixed-point
+    // iteration), the L1 distance between the new y and previous is returned, else 0. finish runs concurrently.
+    template <typename Matrix, typename Scalar, typename Finish>
+    double spmv(const Matrix& matrix, const Scalar* x, Scalar* y, Finish&& finish, const Scalar* previous = nullptr,
+                unsigned threads = Parallel::defaultThreadCount()) {
+        threads = std::max(threads, 1u);
+        std::vector<double> residual(threads, 0.0);
+        Parallel::parallelFor(0, matrix.rows(), SpmvDetail::rowGrain, threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+            double change = 0.0;
+            for (std::size_t row = begin; row < end; ++row) {
+                const auto r = static_cast<std::uint32_t>(row);
+                const Scalar value = finish(r, SpmvDetail::gatherSum(matrix.rowBegin(r), matrix.rowEnd(r), x));
+                y[row] = value;
+                if (previous != nullptr) {
+                    change += std::abs(static_cast<double>(value) - static_cast<double>(previous[row]));
+                }
+            }
+            residual[thread] += change;
+        });
+        double total = 0.0;
+        for (double change : residual) {
+            total += change;
+        }
+        return total;
+    }
+
+}  // namespace GraphAlgorithms
+#endif
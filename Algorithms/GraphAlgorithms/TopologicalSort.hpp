@@ -0,0 +1,48 @@
+// Created by Aaron H 5/28/24
+#ifndef TOPOLOGICALSORT_HPP
+#define TOPOLOGICALSORT_HPP
+#include "GraphTraits.hpp"
+#include "../../Structures/ADT/Graph.hpp"
+#include "../Parallel/ParallelFor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+namespace GraphAlgorithms {
+
+    enum class TopologicalMethod {
+        Kahn,       // Repeatedly removes vertices without remaining in-edges, FIFO
+        DepthFirst  // Reverse DFS finishing order
+    };
+
+    // Orders the vertices so every edge points forward. Works on any graph with the id-level interface; throws
+    // std::runtime_error if the graph has a cycle.
+    template <typename GraphType>
+    std::vector<VertexOf<GraphType>> topologicalSort(const GraphType& graph, TopologicalMethod method = TopologicalMethod::Kahn);
+
+    template <typename GraphType>
+    std::vector<std::uint32_t> topologicalOrderIds(const GraphType& graph, TopologicalMethod method = TopologicalMethod::Kahn);
+
+    // Vertex ids grouped by dependency level: level 0 holds the vertices without in-edges and every other vertex sits
+    // one level after its deepest predecessor, so all vertices of a level can run concurrently once the previous
+    // levels are done. Ids are ascending within a level.
+    struct TopologicalLevels {
+        static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+        std::vector<std::uint32_t> vertices;
+        std::vector<std::size_t> offsets;  // Level k is vertices[offsets[k], offsets[k + 1])
+        std::vector<std::uint32_t> levelOf;  // Per id; ids without a live vertex hold none
+
+        [[nodiscard]] std::size_t numLevels() const { return offsets.size() - 1; }
+        [[nodiscard]] std::size_t levelSize(std::size_t level) const { return offsets[level + 1] - offsets[level]; }
+        const std::uint32_t* levelBegin(std::size_t level) const { return vertices.data() + offsets[level]; }
+        const std::uint32_t* levelEnd(std::size_t level) const { return vertices.data() + offsets[level + 1]; }
+    };
+
+    // Level-synchronous parallel Kahn: in-degrees are atomic counters, and the vertices whose count a level drives
+    // to zero form the next level. Throws std::runtime_error if the graph has a cycle.
+    template <typename GraphType>
+    TopologicalLevels levelize(const GraphType& graph, unsigned threads = Parallel::defaultThreadCount());
+
+}  // namespace GraphAlgorithms
+#include "TopologicalSort.tpp"
+#endif
@@ -0,0 +1,181 @@
+// TopologicalSort.tpp
+#include "TopologicalSort.hpp"
+#include "../Searching/DFS/DFSEngine.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace GraphAlgorithms {
+
+    namespace TopologicalDetail {
+
+        // A back edge means a cycle; otherwise reversed finishing order is topological
+        struct FinishOrderRecorder : Searching::DFSVisitor {
+            std::vector<std::uint32_t> order;
+            bool cyclic = false;
+            void finishVertex(std::uint32_t vertex) { order.push_back(vertex); }
+            void backEdge(std::uint32_t, std::uint32_t) { cyclic = true; }
+            [[nodiscard]] bool stop() const { return cyclic; }
+        };
+
+        inline void throwCyclic() {
+            throw std::runtime_error("Graph has a cycle, so it has no topological order");
+        }
+
+        template <typename GraphType>
+        std::vector<std::uint32_t> kahnOrder(const GraphType& graph) {
+            const std::uint32_t bound = graph.idBound();
+            std::vector<std::uint32_t> inDegree(bound, 0);
+            std::vector<std::uint32_t> order;
+            for (std::uint32_t vertex = 0; vertex < bound; ++vertex) {
+                if (!graph.containsId(vertex)) {
+                    continue;
+                }
+                for (std::size_t index = 0; index < graph.outDegree(vertex); ++index) {
+                    ++inDegree[graph.neighborAt(vertex, index)];
+                }
+            }
+            for (std::uint32_t vertex = 0; vertex < bound; ++vertex) {
+                if (graph.containsId(vertex) && inDegree[vertex] == 0) {
+                    order.push_back(vertex);
+                }
+            }
+            // The output doubles as the FIFO queue
+            for (std::size_t head = 0; head < order.size(); ++head) {
+                const std::uint32_t vertex = order[head];
+                for (std::size_t index = 0; index < graph.outDegree(vertex); ++index) {
+                    const std::uint32_t next = graph.neighborAt(vertex, index);
+                    if (--inDegree[next] == 0) {
+                        order.push_back(next);
+                    }
+                }
+            }
+            std::size_t live = 0;
+            for (std::uint32_t vertex = 0; vertex < bound; ++vertex) {
+                live += graph.containsId(vertex);
+            }
+            if (order.size() != live) {
+                throwCyclic();
+            }
+            return order;
+        }
+
+    }  // namespace TopologicalDetail
+
+    template <typename GraphType>
+    std::vector<std::uint32_t> topologicalOrderIds(const GraphType& graph, TopologicalMethod method) {
+        if (method == TopologicalMethod::Kahn) {
+            return TopologicalDetail::kahnOrder(graph);
+        }
+        Searching::DFSEngine<GraphType> engine(graph);
+        TopologicalDetail::FinishOrderRecorder recorder;
+        recorder.order.reserve(graph.idBound());
+        engine.visitAll(recorder);
+        if (recorder.cyclic) {
+            TopologicalDetail::throwCyclic();
+        }
+        std::reverse(recorder.order.begin(), recorder.order.end());
+        return std::move(recorder.order);
+    }
+
+    template <typename GraphType>
+    std::vector<VertexOf<GraphType>> topologicalSort(const GraphType& graph, TopologicalMethod method) {
+        std::vector<VertexOf<GraphType>> order;
+        const std::vector<std::uint32_t> ids = topologicalOrderIds(graph, method);
+        order.reserve(ids.size());
+        for (std::uint32_t vertex : ids) {
+            order.push_back(graph.vertexOf(vertex));
+        }
+        return order;
+    }
+
+    template <typename GraphType>
+    TopologicalLevels levelize(const GraphType& graph, unsigned threads) {
+        constexpr std::size_t grain = 1024;
+        const std::uint32_t bound = graph.idBound();
+        threads = std::max(threads, 1u);
+
+        std::unique_ptr<std::atomic<std::uint32_t>[]> inDegree(new std::atomic<std::uint32_t>[bound]);
+        for (std::uint32_t vertex = 0; vertex < bound; ++vertex) {
+            inDegree[vertex].store(0, std::memory_order_relaxed);
+        }
+        // Locked read-modify-writes cost several times a plain update, so steps that run on one thread skip them
+        auto adjust = [&](std::uint32_t vertex, bool shared, bool increment) {
+            if (shared) {
+                return increment ? inDegree[vertex].fetch_add(1, std::memory_order_relaxed)
+                                 : inDegree[vertex].fetch_sub(1, std::memory_order_relaxed);
+            }
+            const std::uint32_t old = inDegree[vertex].load(std::memory_order_relaxed);
+            inDegree[vertex].store(increment ? old + 1 : old - 1, std::memory_order_relaxed);
+            return old;
+        };
+        Parallel::parallelFor(0, bound, grain, threads, [&](unsigned, std::size_t begin, std::size_t end) {
+            const bool shared = threads > 1 && bound > grain;
+            for (std::size_t vertex = begin; vertex < end; ++vertex) {
+                if (!graph.containsId(static_cast<std::uint32_t>(vertex))) {
+                    continue;
+                }
+                for (std::size_t index = 0; index < graph.outDegree(static_cast<std::uint32_t>(vertex)); ++index) {
+                    adjust(graph.neighborAt(static_cast<std::uint32_t>(vertex), index), shared, true);
+                }
+            }
+        });
+
+        TopologicalLevels levels;
+        levels.levelOf.assign(bound, TopologicalLevels::none);
+        levels.offsets.push_back(0);
+        std::size_t live = 0;
+        for (std::uint32_t vertex = 0; vertex < bound; ++vertex) {
+            if (!graph.containsId(vertex)) {
+                continue;
+            }
+            ++live;
+            if (inDegree[vertex].load(std::memory_order_relaxed) == 0) {
+                levels.vertices.push_back(vertex);
+            }
+        }
+        levels.vertices.reserve(live);
+
+        std::vector<std::vector<std::uint32_t>> localNext(threads);
+        for (std::uint32_t level = 0; levels.vertices.size() > levels.offsets.back(); ++level) {
+            const std::size_t begin = levels.offsets.back();
+            const std::size_t end = levels.vertices.size();
+            levels.offsets.push_back(end);
+            for (std::size_t index = begin; index < end; ++index) {
+                levels.levelOf[levels.vertices[index]] = level;
+            }
+            // The decrement that reaches zero belongs to the last predecessor, so exactly one thread claims each vertex.
+            // parallelFor's completion wait orders these updates before the next level reads them.
+            const bool shared = threads > 1 && end - begin > grain;
+            Parallel::parallelFor(begin, end, grain, threads, [&](unsigned thread, std::size_t chunkBegin, std::size_t chunkEnd) {
+                auto& next = localNext[thread];
+                for (std::size_t index = chunkBegin; index < chunkEnd; ++index) {
+                    const std::uint32_t vertex = levels.vertices[index];
+                    for (std::size_t edge = 0; edge < graph.outDegree(vertex); ++edge) {
+                        const std::uint32_t successor = graph.neighborAt(vertex, edge);
+                        if (adjust(successor, shared, false) == 1) {
+                            next.push_back(successor);
+                        }
+                    }
+                }
+            });
+            for (auto& next : localNext) {
+                levels.vertices.insert(levels.vertices.end(), next.begin(), next.end());
+                next.clear();
+            }
+        }
+        if (levels.vertices.size() != live) {
+            TopologicalDetail::throwCyclic();
+        }
+        // Levels come out in claim order; one counting pass by level makes them ascending, cheaper than sorting each
+        std::vector<std::size_t> cursor(levels.offsets.begin(), levels.offsets.end() - 1);
+        for (std::uint32_t vertex = 0; vertex < bound; ++vertex) {
+            if (levels.levelOf[vertex] != TopologicalLevels::none) {
+                levels.vertices[cursor[levels.levelOf[vertex]]++] = vertex;
+            }
+        }
+        return levels;
+    }
+
+}  // namespace GraphAlgorithms
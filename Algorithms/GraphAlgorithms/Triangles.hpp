@@ -0,0 +1,55 @@
+// Created by Aaron H 5/28/24
+#ifndef TRIANGLES_HPP
+#define TRIANGLES_HPP
+#include "GraphTraits.hpp"
+#include "../Parallel/ParallelFor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+namespace GraphAlgorithms {
+
+    // Simple undirected view of a graph for triangle listing. Edge directions, self-loops and parallel edges are
+    // dropped, vertices are renumbered by ascending degree (ties by id) and every edge is kept once, at its
+    // lower-ranked endpoint, in a sorted row. A row then only holds neighbors of at least its own degree, so no row
+    // is longer than O(sqrt(edges)) and hubs stop dominating the work.
+    struct DegreeOrderedView {
+        static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+        std::vector<std::uint32_t> rankOf;    // Per id of the source graph; ids without a live vertex hold none
+        std::vector<std::uint32_t> idOfRank;
+        std::vector<std::uint32_t> degree;    // Undirected degree per rank
+        std::vector<std::size_t> offsets;     // Higher-ranked neighbors of rank r are targets[offsets[r], offsets[r + 1])
+        std::vector<std::uint32_t> targets;
+
+        [[nodiscard]] std::uint32_t numVertices() const { return static_cast<std::uint32_t>(idOfRank.size()); }
+        [[nodiscard]] std::size_t numEdges() const { return targets.size(); }
+        [[nodiscard]] std::size_t forwardDegree(std::uint32_t rank) const { return offsets[rank + 1] - offsets[rank]; }
+        const std::uint32_t* neighborsBegin(std::uint32_t rank) const { return targets.data() + offsets[rank]; }
+        const std::uint32_t* neighborsEnd(std::uint32_t rank) const { return targets.data() + offsets[rank + 1]; }
+    };
+
+    // Works on any graph with the id-level interface, e.g. a DerivedGraph of type UDG or its frozen CSRGraph
+    template <typename GraphType>
+    DegreeOrderedView degreeOrderedView(const GraphType& graph, unsigned threads = Parallel::defaultThreadCount());
+
+    // Triangles of the undirected graph underneath graph. Every edge (u, v) of the view intersects the rows of u and
+    // v with the SIMD kernels of SetIntersection.hpp; rows are spread over threads in small dynamically claimed
+    // chunks, since their cost varies with degree.
+    template <typename GraphType>
+    std::uint64_t countTriangles(const GraphType& graph, unsigned threads = Parallel::defaultThreadCount());
+
+    inline std::uint64_t countTriangles(const DegreeOrderedView& view, unsigned threads = Parallel::defaultThreadCount());
+
+    // Triangles through each vertex, indexed by id; ids without a live vertex hold 0
+    template <typename GraphType>
+    std::vector<std::uint64_t> trianglesPerVertex(const GraphType& graph, unsigned threads = Parallel::defaultThreadCount());
+
+    // Local clustering coefficient per id: the fraction of pairs of a vertex's neighbors that are adjacent themselves,
+    // 2 t(v) / (d(v) (d(v) - 1)) with t(v) its triangles and d(v) its undirected degree. Vertices with fewer than two
+    // neighbors and ids without a live vertex get 0.
+    template <typename GraphType>
+    std::vector<double> clusteringCoefficients(const GraphType& graph, unsigned threads = Parallel::defaultThreadCount());
+
+}  // namespace GraphAlgorithms
+#include "Triangles.tpp"
+#endif
@@ -0,0 +1,221 @@
+// Triangles.tpp
+#include "Triangles.hpp"
+#include "SetIntersection.hpp"
+#include "../Sorting/PdqSort.hpp"
+#include "../Sorting/RadixSort.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace GraphAlgorithms {
+
+    namespace TriangleDetail {
+
+        constexpr std::size_t rowGrain = 256;     // Rows per chunk while building the view
+        constexpr std::size_t countGrain = 64;    // Rows per chunk while counting; small, as row costs are skewed
+
+        // Triangles through each rank of view. A triangle u < v < w (by rank) is found once, as w in the
+        // intersection of the rows of u and v, and credited to all three.
+        inline std::vector<std::uint64_t> trianglesByRank(const DegreeOrderedView& view, unsigned threads) {
+            const std::uint32_t n = view.numVertices();
+            std::unique_ptr<std::atomic<std::uint64_t>[]> triangles(new std::atomic<std::uint64_t>[n]);
+            for (std::uint32_t rank = 0; rank < n; ++rank) {
+                triangles[rank].store(0, std::memory_order_relaxed);
+            }
+            // Locked read-modify-writes cost several times a plain update, so a single thread skips them
+            const bool shared = threads > 1 && n > countGrain;
+            auto credit = [&](std::uint32_t rank, std::uint64_t amount) {
+                if (shared) {
+                    triangles[rank].fetch_add(amount, std::memory_order_relaxed);
+                } else {
+                    triangles[rank].store(triangles[rank].load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+                }
+            };
+            Parallel::parallelFor(0, n, countGrain, threads, [&](unsigned, std::size_t begin, std::size_t end) {
+                for (std::size_t u = begin; u < end; ++u) {
+                    const std::uint32_t* row = view.neighborsBegin(static_cast<std::uint32_t>(u));
+                    const std::size_t size = view.forwardDegree(static_cast<std::uint32_t>(u));
+                    std::uint64_t own = 0;
+                    for (std::size_t k = 0; k < size; ++k) {
+                        const std::uint32_t v = row[k];
+                        // Row entries up to v are below v, so only the rest can close a triangle with v's row
+                        const std::size_t common = intersectSorted(row + k + 1, size - k - 1, view.neighborsBegin(v), view.forwardDegree(v),
+                                                                   [&](std::uint32_t w) { credit(w, 1); });
+                        if (common != 0) {
+                            credit(v, common);
+                            own += common;
+                        }
+                    }
+                    if (own != 0) {
+                        credit(static_cast<std::uint32_t>(u), own);
+                    }
+                }
+            });
+            std::vector<std::uint64_t> result(n);
+            for (std::uint32_t rank = 0; rank < n; ++rank) {
+                result[rank] = triangles[rank].load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+    }  // namespace TriangleDetail
+
+    template <typename GraphType>
+    DegreeOrderedView degreeOrderedView(const GraphType& graph, unsigned threads) {
+        static_assert(IsIdGraph<GraphType>::value, "Triangle counting needs the id-level graph interface");
+        using TriangleDetail::rowGrain;
+        threads = std::max(threads, 1u);
+        const std::uint32_t bound = graph.idBound();
+
+        // Symmetric rows, duplicates included: every edge lands in the rows of both endpoints
+        std::vector<std::size_t> offsets(static_cast<std::size_t>(bound) + 1, 0);
+        for (std::uint32_t u = 0; u < bound; ++u) {
+            if (!graph.containsId(u)) {
+                continue;
+            }
+            for (std::size_t index = 0; index < graph.outDegree(u); ++index) {
+                const std::uint32_t v = graph.neighborAt(u, index);
+                if (v != u) {
+                    ++offsets[u + 1];
+                    ++offsets[v + 1];
+                }
+            }
+        }
+        for (std::uint32_t u = 0; u < bound; ++u) {
+            offsets[u + 1] += offsets[u];
+        }
+        std::vector<std::uint32_t> neighbors(offsets[bound]);
+        {
+            std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (std::uint32_t u = 0; u < bound; ++u) {
+                if (!graph.containsId(u)) {
+                    continue;
+                }
+                for (std::size_t index = 0; index < graph.outDegree(u); ++index) {
+                    const std::uint32_t v = graph.neighborAt(u, index);
+                    if (v != u) {
+                        neighbors[cursor[u]++] = v;
+                        neighbors[cursor[v]++] = u;
+                    }
+                }
+            }
+        }
+        // Sorting a row and dropping repeats leaves its distinct neighbors in front
+        std::vector<std::uint32_t> degree(bound, 0);
+        Parallel::parallelFor(0, bound, rowGrain, threads, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t u = begin; u < end; ++u) {
+                std::uint32_t* rowBegin = neighbors.data() + offsets[u];
+                std::uint32_t* rowEnd = neighbors.data() + offsets[u + 1];
+                Sorting::pdqsort(rowBegin, rowEnd);
+                degree[u] = static_cast<std::uint32_t>(std::unique(rowBegin, rowEnd) - rowBegin);
+            }
+        });
+
+        DegreeOrderedView view;
+        std::vector<std::uint64_t> byDegree;
+        for (std::uint32_t u = 0; u < bound; ++u) {
+            if (graph.containsId(u)) {
+                byDegree.push_back(static_cast<std::uint64_t>(degree[u]) << 32 | u);
+            }
+        }
+        Sorting::radixSort(byDegree.begin(), byDegree.end());
+        const auto n = static_cast<std::uint32_t>(byDegree.size());
+        view.rankOf.assign(bound, DegreeOrderedView::none);
+        view.idOfRank.resize(n);
+        view.degree.resize(n);
+        for (std::uint32_t rank = 0; rank < n; ++rank) {
+            const auto id = static_cast<std::uint32_t>(byDegree[rank]);
+            view.idOfRank[rank] = id;
+            view.degree[rank] = degree[id];
+            view.rankOf[id] = rank;
+        }
+
+        // Keep each edge at its lower-ranked endpoint, in rank space
+        view.offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+        Parallel::parallelFor(0, n, rowGrain, threads, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t rank = begin; rank < end; ++rank) {
+                const std::uint32_t id = view.idOfRank[rank];
+                const std::uint32_t* row = neighbors.data() + offsets[id];
+                std::size_t forward = 0;
+                for (std::uint32_t k = 0; k < degree[id]; ++k) {
+                    forward += view.rankOf[row[k]] > rank;
+                }
+                view.offsets[rank + 1] = forward;
+            }
+        });
+        for (std::uint32_t rank = 0; rank < n; ++rank) {
+            view.offsets[rank + 1] += view.offsets[rank];
+        }
+        view.targets.resize(view.offsets[n]);
+        Parallel::parallelFor(0, n, rowGrain, threads, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t rank = begin; rank < end; ++rank) {
+                const std::uint32_t id = view.idOfRank[rank];
+                const std::uint32_t* row = neighbors.data() + offsets[id];
+                std::uint32_t* out = view.targets.data() + view.offsets[rank];
+                for (std::uint32_t k = 0; k < degree[id]; ++k) {
+                    const std::uint32_t neighborRank = view.rankOf[row[k]];
+                    if (neighborRank > rank) {
+                        *out++ = neighborRank;
+                    }
+                }
+                Sorting::pdqsort(view.targets.data() + view.offsets[rank], out);
+            }
+        });
+        return view;
+    }
+
+    inline std::uint64_t countTriangles(const DegreeOrderedView& view, unsigned threads) {
+        threads = std::max(threads, 1u);
+        std::vector<std::uint64_t> perThread(threads, 0);
+        Parallel::parallelFor(0, view.numVertices(), TriangleDetail::countGrain, threads,
+                              [&](unsigned thread, std::size_t begin, std::size_t end) {
+            std::uint64_t found = 0;
+            for (std::size_t u = begin; u < end; ++u) {
+                const std::uint32_t* row = view.neighborsBegin(static_cast<std::uint32_t>(u));
+                const std::size_t size = view.forwardDegree(static_cast<std::uint32_t>(u));
+                for (std::size_t k = 0; k < size; ++k) {
+                    found += intersectionSize(row + k + 1, size - k - 1, view.neighborsBegin(row[k]), view.forwardDegree(row[k]));
+                }
+            }
+            perThread[thread] += found;
+        });
+        std::uint64_t total = 0;
+        for (std::uint64_t found : perThread) {
+            total += found;
+        }
+        return total;
+    }
+
+    template <typename GraphType>
+    std::uint64_t countTriangles(const GraphType& graph, unsigned threads) {
+        return countTriangles(degreeOrderedView(graph, threads), threads);
+    }
+
+    template <typename GraphType>
+    std::vector<std::uint64_t> trianglesPerVertex(const GraphType& graph, unsigned threads) {
+        threads = std::max(threads, 1u);
+        const DegreeOrderedView view = degreeOrderedView(graph, threads);
+        const std::vector<std::uint64_t> byRank = TriangleDetail::trianglesByRank(view, threads);
+        std::vector<std::uint64_t> result(graph.idBound(), 0);
+        for (std::uint32_t rank = 0; rank < view.numVertices(); ++rank) {
+            result[view.idOfRank[rank]] = byRank[rank];
+        }
+        return result;
+    }
+
+    template <typename GraphType>
+    std::vector<double> clusteringCoefficients(const GraphType& graph, unsigned threads) {
+        threads = std::max(threads, 1u);
+        const DegreeOrderedView view = degreeOrderedView(graph, threads);
+        const std::vector<std::uint64_t> byRank = TriangleDetail::trianglesByRank(view, threads);
+        std::vector<double> result(graph.idBound(), 0.0);
+        for (std::uint32_t rank = 0; rank < view.numVertices(); ++rank) {
+            const double degree = view.degree[rank];
+            if (degree >= 2) {
+                result[view.idOfRank[rank]] = 2.0 * static_cast<double>(byRank[rank]) / (degree * (degree - 1));
+            }
+        }
+        return result;
+    }
+
+}  // namespace GraphAlgorithms
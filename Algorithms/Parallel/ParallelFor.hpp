@@ -0,0 +1,228 @@
+// ParallelFor.hpp
+#ifndef PARALLELFOR_HPP
+#define PARALLELFOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Parallel {
+
+    inline unsigned defaultThreadCount() {
+        unsigned count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    namespace ParallelDetail {
+
+        // Type-erased task(threadIndex) for the pool, without allocating per call
+        struct Task {
+            void (*invoke)(void* context, unsigned threadIndex) = nullptr;
+            void* context = nullptr;
+        };
+
+        // Worker threads started on first use and kept for the life of the process, so algorithms that call
+        // parallelFor once per level, phase or iteration pay a wake-up instead of a thread spawn and join each time.
+        // Workers spin briefly after a task before sleeping, since the next call usually follows within microseconds.
+        class WorkerPool {
+        public:
+            static WorkerPool& instance() {
+                static WorkerPool pool;
+                return pool;
+            }
+
+            // True on the threads running a task, where a nested parallelFor must not wait on the pool it occupies
+            static bool& insideTask() {
+                thread_local bool inside = false;
+                return inside;
+            }
+
+            // Runs task on thread indices [0, threads), index 0 on the calling thread, and returns once all of them
+            // finished, rethrowing the first exception. Returns false without running anything if another thread is
+            // using the pool.
+            bool run(unsigned threads, Task task) {
+                std::unique_lock<std::mutex> claim(claimMutex, std::try_to_lock);
+                if (!claim.owns_lock()) {
+                    return false;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    while (workers.size() + 1 < threads) {
+                        const auto threadIndex = static_cast<unsigned>(workers.size() + 1);
+                        workers.emplace_back([this, threadIndex] { workerLoop(threadIndex); });
+                    }
+                    current = task;
+                    participants = threads;
+                    error = nullptr;
+                    pending.store(threads - 1, std::memory_order_relaxed);
+                    generation.fetch_add(1, std::memory_order_release);
+                }
+                wake.notify_all();
+
+                std::exception_ptr callerError;
+                insideTask() = true;
+                try {
+                    task.invoke(task.context, 0);
+                } catch (...) {
+                    callerError = std::current_exception();
+                }
+                insideTask() = false;
+
+                for (unsigned spin = 0; spin < spinLimit && pending.load(std::memory_order_acquire) != 0; ++spin) {
+                    std::this_thread::yield();
+                }
+                std::unique_lock<std::mutex> lock(mutex);
+                done.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+                if (!callerError) {
+                    callerError = error;
+                }
+                lock.unlock();
+                if (callerError) {
+                    std::rethrow_exception(callerError);
+                }
+                return true;
+            }
+
+            ~WorkerPool() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }
+
+        private:
+            static constexpr unsigned spinLimit = 4096;  // Yields before blocking on the condition variable
+
+            WorkerPool() = default;
+
+            void workerLoop(unsigned threadIndex) {
+                insideTask() = true;
+                std::uint64_t seen = 0;
+                for (;;) {
+                    for (unsigned spin = 0; spin < spinLimit && generation.load(std::memory_order_acquire) == seen; ++spin) {
+                        std::this_thread::yield();
+                    }
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [&] { return stopping || generation.load(std::memory_order_relaxed) != seen; });
+                    if (stopping) {
+                        return;
+                    }
+                    seen = generation.load(std::memory_order_relaxed);
+                    if (threadIndex >= participants) {
+                        continue;
+                    }
+                    const Task task = current;
+                    lock.unlock();
+                    try {
+                        task.invoke(task.context, threadIndex);
+                    } catch (...) {
+                        lock.lock();
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                        lock.unlock();
+                    }
+                    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        std::lock_guard<std::mutex> finished(mutex);
+                        done.notify_one();
+                    }
+                }
+            }
+
+            std::mutex claimMutex;  // Held by the caller for a whole run
+            std::mutex mutex;       // Guards the fields below and the condition variables
+            std::condition_variable wake;
+            std::condition_variable done;
+            std::vector<std::thread> workers;
+            Task current;
+            unsigned participants = 0;
+            std::exception_ptr error;
+            bool stopping = false;
+            std::atomic<std::uint64_t> generation{0};
+            std::atomic<unsigned> pending{0};
+        };
+
+        // Fallback while the pool is busy with another caller. Like WorkerPool::run it joins every thread before
+        // rethrowing the first exception any of them raised.
+        template <typename Worker>
+        void runOnTemporaryThreads(unsigned threads, Worker& worker) {
+            std::mutex errorMutex;
+            std::exception_ptr error;
+            auto guarded = [&](unsigned threadIndex) {
+                try {
+                    worker(threadIndex);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+            };
+            std::vector<std::thread> pool;
+            pool.reserve(threads - 1);
+            try {
+                for (unsigned threadIndex = 1; threadIndex < threads; ++threadIndex) {
+                    pool.emplace_back(guarded, threadIndex);
+                }
+            } catch (...) {
+                // Running threads must still be joined before their shared state goes away; chunks they did not
+                // claim fall to this thread below
+                std::lock_guard<std::mutex> lock(errorMutex);
+                error = std::current_exception();
+            }
+            guarded(0u);
+            for (auto& thread : pool) {
+                thread.join();
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+    }  // namespace ParallelDetail
+
+    // Splits [begin, end) into chunks of grain indices that threads claim dynamically, so skewed work still balances.
+    // body(threadIndex, chunkBegin, chunkEnd) runs on threadIndex in [0, threads); the calling thread is thread 0.
+    // Chunk boundaries are begin + k * grain, which lets callers align chunks (e.g. to bitmap words). The other threads
+    // come from a persistent pool; a parallelFor nested inside a body runs on its calling thread alone. Returns after
+    // every chunk finished, with their writes visible to the caller.
+    template <typename Body>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, unsigned threads, Body&& body) {
+        if (begin >= end) {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (end - begin + grain - 1) / grain;
+        threads = static_cast<unsigned>(std::min<std::size_t>(std::max(threads, 1u), chunks));
+        if (threads == 1 || ParallelDetail::WorkerPool::insideTask()) {
+            body(0u, begin, end);
+            return;
+        }
+        std::atomic<std::size_t> nextChunk{0};
+        auto worker = [&](unsigned threadIndex) {
+            for (std::size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+                 chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+                const std::size_t chunkBegin = begin + chunk * grain;
+                body(threadIndex, chunkBegin, std::min(chunkBegin + grain, end));
+            }
+        };
+        const ParallelDetail::Task task{
+            [](void* context, unsigned threadIndex) { (*static_cast<decltype(worker)*>(context))(threadIndex); }, &worker};
+        if (!ParallelDetail::WorkerPool::instance().run(threads, task)) {
+            ParallelDetail::runOnTemporaryThreads(threads, worker);
+        }
+    }
+
+}  // namespace Parallel
+
+#endif  // PARALLELFOR_HPP
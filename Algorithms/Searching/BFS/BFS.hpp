@@ -0,0 +1,39 @@
+// BFS.hpp
+#ifndef BFS_HPP
+#define BFS_HPP
+
+#include "../../../Structures/ADT/CSRGraph.hpp"
+#include "../../Parallel/ParallelFor.hpp"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace Searching {
+
+    struct BFSOptions {
+        unsigned threads = Parallel::defaultThreadCount();
+        // Beamer's switching thresholds: go bottom-up once the frontier's out-edges exceed 1/alpha of the edges
+        // still unexplored, return top-down once the frontier shrinks below 1/beta of the vertices
+        double alpha = 15.0;
+        double beta = 18.0;
+    };
+
+    // Per dense vertex id; the source is its own parent at depth 0
+    struct BFSResult {
+        static constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+        std::vector<std::uint32_t> parent;
+        std::vector<std::uint32_t> depth;
+    };
+
+    // Direction-optimizing, level-synchronous parallel BFS. Top-down steps expand a frontier queue, bottom-up steps
+    // let every unvisited vertex scan its in-edges against a frontier bitmap; the latter needs freeze(true).
+    template <typename VerticeType, typename EdgeType>
+    BFSResult BFS(const CSRGraph<VerticeType, EdgeType>& graph, const VerticeType& source, const BFSOptions& options = BFSOptions());
+
+    template <typename VerticeType, typename EdgeType>
+    BFSResult BFSFromId(const CSRGraph<VerticeType, EdgeType>& graph, std::uint32_t source, const BFSOptions& options = BFSOptions());
+
+}  // end of namespace Searching
+
+#include "BFS.tpp"
+#endif  // BFS_HPP
@@ -0,0 +1,135 @@
+// BFS.tpp
+#include "BFS.hpp"
+#include <memory>
+#include <stdexcept>
+
+namespace Searching {
+
+    template <typename VerticeType, typename EdgeType>
+    BFSResult BFS(const CSRGraph<VerticeType, EdgeType>& graph, const VerticeType& source, const BFSOptions& options) {
+        return BFSFromId(graph, graph.idOf(source), options);
+    }
+
+    template <typename VerticeType, typename EdgeType>
+    BFSResult BFSFromId(const CSRGraph<VerticeType, EdgeType>& graph, std::uint32_t source, const BFSOptions& options) {
+        using VertexId = std::uint32_t;
+        constexpr VertexId unreached = BFSResult::unreached;
+        constexpr std::size_t topDownGrain = 256;
+        constexpr std::size_t bottomUpGrain = 64 * 64;  // Whole bitmap words, so each word has one writer
+
+        const std::size_t n = graph.numVertices();
+        if (source >= n) {
+            throw std::out_of_range("BFS source id is out of range");
+        }
+        const unsigned threads = std::max(options.threads, 1u);
+        BFSResult result;
+        result.parent.assign(n, unreached);
+        // Depth doubles as the claim flag: a vertex belongs to whoever moves it off unreached first
+        std::unique_ptr<std::atomic<VertexId>[]> depth(new std::atomic<VertexId>[n]);
+        for (std::size_t id = 0; id < n; ++id) {
+            depth[id].store(unreached, std::memory_order_relaxed);
+        }
+
+        depth[source].store(0, std::memory_order_relaxed);
+        result.parent[source] = source;
+        std::vector<VertexId> frontier{source};
+        std::vector<std::uint64_t> frontierBits;
+        std::vector<std::uint64_t> nextBits;
+        std::vector<std::vector<VertexId>> localNext(threads);
+        // Per-thread totals, added to once per chunk so neighboring slots are not written in the inner loops
+        std::vector<std::size_t> localEdges(threads);
+        std::vector<std::size_t> localCount(threads);
+
+        std::size_t frontierSize = 1;
+        std::size_t frontierEdges = graph.outDegree(source);
+        std::size_t unexploredEdges = graph.numEdges() - frontierEdges;
+        bool bottomUp = false;
+
+        for (VertexId level = 0; frontierSize > 0; ++level) {
+            if (graph.hasInEdges()) {
+                if (!bottomUp && static_cast<double>(frontierEdges) > static_cast<double>(unexploredEdges) / options.alpha) {
+                    bottomUp = true;
+                    frontierBits.assign((n + 63) / 64, 0);
+                    for (VertexId vertex : frontier) {
+                        frontierBits[vertex >> 6] |= std::uint64_t{1} << (vertex & 63);
+                    }
+                } else if (bottomUp && static_cast<double>(frontierSize) < static_cast<double>(n) / options.beta) {
+                    bottomUp = false;
+                    frontier.clear();
+                    for (std::size_t word = 0; word < frontierBits.size(); ++word) {
+                        for (std::uint64_t bits = frontierBits[word]; bits != 0; bits &= bits - 1) {
+                            frontier.push_back(static_cast<VertexId>(word * 64 + __builtin_ctzll(bits)));
+                        }
+                    }
+                }
+            }
+            std::fill(localEdges.begin(), localEdges.end(), 0);
+            std::fill(localCount.begin(), localCount.end(), 0);
+
+            if (bottomUp) {
+                nextBits.assign(frontierBits.size(), 0);
+                Parallel::parallelFor(0, n, bottomUpGrain, threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+                    std::size_t count = 0;
+                    std::size_t edges = 0;
+                    for (std::size_t id = begin; id < end; ++id) {
+                        if (depth[id].load(std::memory_order_relaxed) != unreached) {
+                            continue;
+                        }
+                        for (auto iter = graph.inNeighborsBegin(id); iter != graph.inNeighborsEnd(id); ++iter) {
+                            if (frontierBits[*iter >> 6] >> (*iter & 63) & 1) {
+                                depth[id].store(level + 1, std::memory_order_relaxed);
+                                result.parent[id] = *iter;
+                                nextBits[id >> 6] |= std::uint64_t{1} << (id & 63);
+                                ++count;
+                                edges += graph.outDegree(id);
+                                break;
+                            }
+                        }
+                    }
+                    localCount[thread] += count;
+                    localEdges[thread] += edges;
+                });
+                frontierBits.swap(nextBits);
+            } else {
+                Parallel::parallelFor(0, frontier.size(), topDownGrain, threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+                    auto& next = localNext[thread];
+                    std::size_t edges = 0;
+                    for (std::size_t index = begin; index < end; ++index) {
+                        const VertexId vertex = frontier[index];
+                        for (auto iter = graph.neighborsBegin(vertex); iter != graph.neighborsEnd(vertex); ++iter) {
+                            VertexId expected = unreached;
+                            if (depth[*iter].load(std::memory_order_relaxed) == unreached
+                                && depth[*iter].compare_exchange_strong(expected, level + 1, std::memory_order_relaxed)) {
+                                result.parent[*iter] = vertex;
+                                next.push_back(*iter);
+                                edges += graph.outDegree(*iter);
+                            }
+                        }
+                    }
+                    localEdges[thread] += edges;
+                });
+                frontier.clear();
+                for (auto& next : localNext) {
+                    frontier.insert(frontier.end(), next.begin(), next.end());
+                    next.clear();
+                }
+                localCount[0] = frontier.size();
+            }
+
+            frontierSize = 0;
+            frontierEdges = 0;
+            for (unsigned thread = 0; thread < threads; ++thread) {
+                frontierSize += localCount[thread];
+                frontierEdges += localEdges[thread];
+            }
+            unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+        }
+
+        result.depth.resize(n);
+        for (std::size_t id = 0; id < n; ++id) {
+            result.depth[id] = depth[id].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+}  // end of namespace Searching
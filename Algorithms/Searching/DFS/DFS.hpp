@@ -3,16 +3,17 @@
 #define DFS_HPP
 
 #include "../../../Structures/ADT/Graph.hpp"
-#include <unordered_map>
+#include "DFSEngine.hpp"
+#include <vector>
 
 namespace Searching {
 
-    template <typename VerticeType, typename EdgeType>
-    void DFSUtil(DerivedGraph<VerticeType, EdgeType>& graph, const VerticeType& vertex, std::unordered_map<VerticeType, bool>& visited);
-
-    template <typename VerticeType, typename EdgeType>
-    void DFS(DerivedGraph<VerticeType, EdgeType>& graph, const VerticeType& start);
+    // Returns the vertices reachable from start in the order they were first visited. Works on any graph with the
+    // id-level interface (see GraphTraits.hpp).
+    template <typename GraphType>
+    std::vector<GraphAlgorithms::VertexOf<GraphType>> DFS(const GraphType& graph, const GraphAlgorithms::VertexOf<GraphType>& start);
 
 }  // end of namespace Searching
 
-#endif  // DFS_HPP
\ No newline at end of file
+#include "DFS.tpp"
+#endif  // DFS_HPP
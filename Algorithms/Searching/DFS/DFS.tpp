@@ -0,0 +1,25 @@
+// DFS.tpp
+#include "DFS.hpp"
+
+namespace Searching {
+
+    // Records vertices in the order they are first discovered
+    template <typename GraphType, typename VerticeType>
+    struct PreorderRecorder : DFSVisitor {
+        const GraphType& graph;
+        std::vector<VerticeType>& order;
+        PreorderRecorder(const GraphType& graph, std::vector<VerticeType>& order) : graph(graph), order(order) {}
+        void discoverVertex(std::uint32_t vertex) { order.push_back(graph.vertexOf(vertex)); }
+    };
+
+    template <typename GraphType>
+    std::vector<GraphAlgorithms::VertexOf<GraphType>> DFS(const GraphType& graph, const GraphAlgorithms::VertexOf<GraphType>& start) {
+        using VerticeType = GraphAlgorithms::VertexOf<GraphType>;
+        std::vector<VerticeType> order;
+        DFSEngine<GraphType> engine(graph);
+        PreorderRecorder<GraphType, VerticeType> recorder(graph, order);
+        engine.visit(graph.idOf(start), recorder);
+        return order;
+    }
+
+}  // end of namespace Searching
@@ -0,0 +1,112 @@
+// DFSEngine.hpp
+#ifndef DFSENGINE_HPP
+#define DFSENGINE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "../../GraphAlgorithms/GraphTraits.hpp"
+
+namespace Searching {
+
+    // No-op hooks for DFSEngine. Visitors derive from this and shadow the hooks they need; the engine is templated
+    // on the visitor type so every hook is a direct, inlinable call. stop() returning true ends the search early.
+    struct DFSVisitor {
+        void discoverVertex(std::uint32_t) {}
+        void finishVertex(std::uint32_t) {}
+        void treeEdge(std::uint32_t, std::uint32_t) {}
+        void backEdge(std::uint32_t, std::uint32_t) {}
+        void forwardOrCrossEdge(std::uint32_t, std::uint32_t) {}
+        [[nodiscard]] bool stop() const { return false; }
+    };
+
+    enum DFSColor : unsigned char { White, Gray, Black };
+
+    // Vertex colors packed two bits each, 32 vertices per word: a quarter of a byte per vertex. reset() clears
+    // idBound / 32 words.
+    class PackedColorMap {
+    public:
+        explicit PackedColorMap(std::size_t count) : words((count + 31) / 32, 0) {}
+
+        [[nodiscard]] DFSColor get(std::uint32_t vertex) const {
+            return static_cast<DFSColor>(words[vertex >> 5] >> ((vertex & 31) * 2) & 3);
+        }
+        void set(std::uint32_t vertex, DFSColor color) {
+            std::uint64_t& word = words[vertex >> 5];
+            const unsigned shift = (vertex & 31) * 2;
+            word = (word & ~(std::uint64_t{3} << shift)) | std::uint64_t{color} << shift;
+        }
+        void resize(std::size_t count) { words.resize((count + 31) / 32, 0); }
+        void clear() { std::fill(words.begin(), words.end(), 0); }
+
+    private:
+        std::vector<std::uint64_t> words;
+    };
+
+    // Epoch-stamped colors for an engine that is reset between many small searches: a stamp below the epoch reads as
+    // White, so reset() advances the epoch in O(1) instead of clearing. Costs four bytes per vertex.
+    class EpochColorMap {
+    public:
+        explicit EpochColorMap(std::size_t count) : stamps(count, 0) {}
+
+        [[nodiscard]] DFSColor get(std::uint32_t vertex) const {
+            const std::uint32_t stamp = stamps[vertex];
+            return stamp < epoch ? White : static_cast<DFSColor>(stamp - epoch + 1);
+        }
+        void set(std::uint32_t vertex, DFSColor color) { stamps[vertex] = color == White ? 0 : epoch + color - 1; }
+        void resize(std::size_t count) { stamps.resize(count, 0); }
+        void clear() {
+            if (epoch >= std::numeric_limits<std::uint32_t>::max() - 2) {
+                std::fill(stamps.begin(), stamps.end(), 0);
+                epoch = 1;
+                return;
+            }
+            epoch += 2;
+        }
+
+    private:
+        std::vector<std::uint32_t> stamps;
+        std::uint32_t epoch = 1;  // Gray is epoch, Black is epoch + 1
+    };
+
+    // Iterative depth-first search over vertex ids. Keeps its own heap stack of (vertex, next neighbor) frames so
+    // path-shaped graphs with millions of vertices cannot overflow the call stack. Works on any graph exposing
+    // idBound(), containsId(id), outDegree(id) and neighborAt(id, index); state is reused across visits. Colors live
+    // in a ColorMap: PackedColorMap by default, EpochColorMap when the engine is reset far more often than it fills.
+    template <typename GraphType, typename ColorMap = PackedColorMap>
+    class DFSEngine {
+        static_assert(GraphAlgorithms::IsIdGraph<GraphType>::value, "DFSEngine needs the id-level graph interface");
+    public:
+        using VertexId = std::uint32_t;
+
+        explicit DFSEngine(const GraphType& graph);
+
+        // Explores everything reachable from root that is not yet discovered. Returns false if the visitor stopped.
+        template <typename Visitor>
+        bool visit(VertexId root, Visitor& visitor);
+
+        // Runs visit() from every live vertex in id order
+        template <typename Visitor>
+        bool visitAll(Visitor& visitor);
+
+        [[nodiscard]] bool discovered(VertexId vertex) const { return colors.get(vertex) != White; }
+        // Forgets every visit and picks up vertices added to the graph since
+        void reset();
+
+    private:
+        struct Frame {
+            VertexId vertex;
+            std::size_t next;
+        };
+
+        const GraphType& graph;
+        ColorMap colors;
+        std::vector<Frame> stack;
+    };
+
+}  // end of namespace Searching
+
+#include "DFSEngine.tpp"
+#endif  // DFSENGINE_HPP
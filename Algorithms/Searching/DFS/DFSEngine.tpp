@@ -0,0 +1,68 @@
+// DFSEngine.tpp
+#include "DFSEngine.hpp"
+
+namespace Searching {
+
+    template <typename GraphType, typename ColorMap>
+    DFSEngine<GraphType, ColorMap>::DFSEngine(const GraphType& graph) : graph(graph), colors(graph.idBound()) {}
+
+    template <typename GraphType, typename ColorMap>
+    template <typename Visitor>
+    bool DFSEngine<GraphType, ColorMap>::visit(VertexId root, Visitor& visitor) {
+        if (colors.get(root) != White) {
+            return true;
+        }
+        colors.set(root, Gray);
+        visitor.discoverVertex(root);
+        if (visitor.stop()) {
+            return false;
+        }
+        stack.push_back({root, 0});
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            const VertexId vertex = frame.vertex;
+            if (frame.next == graph.outDegree(vertex)) {
+                colors.set(vertex, Black);
+                stack.pop_back();
+                visitor.finishVertex(vertex);
+            } else {
+                const VertexId next = graph.neighborAt(vertex, frame.next++);
+                const DFSColor color = colors.get(next);
+                if (color == White) {
+                    visitor.treeEdge(vertex, next);
+                    colors.set(next, Gray);
+                    visitor.discoverVertex(next);
+                    stack.push_back({next, 0});
+                } else if (color == Gray) {
+                    visitor.backEdge(vertex, next);
+                } else {
+                    visitor.forwardOrCrossEdge(vertex, next);
+                }
+            }
+            if (visitor.stop()) {
+                stack.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename GraphType, typename ColorMap>
+    template <typename Visitor>
+    bool DFSEngine<GraphType, ColorMap>::visitAll(Visitor& visitor) {
+        for (VertexId root = 0; root < graph.idBound(); ++root) {
+            if (graph.containsId(root) && !visit(root, visitor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename GraphType, typename ColorMap>
+    void DFSEngine<GraphType, ColorMap>::reset() {
+        colors.resize(graph.idBound());
+        colors.clear();
+        stack.clear();
+    }
+
+}  // end of namespace Searching
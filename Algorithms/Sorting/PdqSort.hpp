@@ -0,0 +1,47 @@
+// Created by Aaron H 5/28/24
+#ifndef PDQSORT_HPP
+#define PDQSORT_HPP
+#include <functional>
+#include <iterator>
+#include <type_traits>
+namespace Sorting {
+
+    // Pattern-defeating quicksort: introsort-style quicksort whose pivots come from a median of three (a pseudo
+    // ninther on large ranges), that finishes sorted and nearly sorted runs with a bounded insertion sort, puts
+    // elements equal to an earlier pivot in place with a single partition, and breaks up adversarial patterns by
+    // shuffling around a bad pivot before falling back to heapsort. O(n log n) worst case, O(n) on sorted, reversed
+    // and all-equal input. Not stable.
+    template <typename Iterator, typename Compare>
+    void pdqsort(Iterator first, Iterator last, Compare comp);
+
+    template <typename Iterator>
+    void pdqsort(Iterator first, Iterator last) { pdqsort(first, last, std::less<>()); }
+
+    // Same algorithm with the block partition forced on: comparisons fill offset buffers without branching and the
+    // misplaced elements are swapped afterwards, which avoids mispredictions when comparisons are cheap and their
+    // outcome is random. pdqsort() picks it by itself for arithmetic values compared with std::less or std::greater.
+    template <typename Iterator, typename Compare>
+    void pdqsortBranchless(Iterator first, Iterator last, Compare comp);
+
+    namespace PdqDetail {
+
+        template <typename Compare, typename Value>
+        struct IsPlainOrder : std::false_type {};
+        template <typename Value>
+        struct IsPlainOrder<std::less<>, Value> : std::true_type {};
+        template <typename Value>
+        struct IsPlainOrder<std::less<Value>, Value> : std::true_type {};
+        template <typename Value>
+        struct IsPlainOrder<std::greater<>, Value> : std::true_type {};
+        template <typename Value>
+        struct IsPlainOrder<std::greater<Value>, Value> : std::true_type {};
+
+        template <typename Iterator, typename Compare>
+        constexpr bool prefersBranchless = std::is_arithmetic_v<typename std::iterator_traits<Iterator>::value_type>
+                && IsPlainOrder<Compare, typename std::iterator_traits<Iterator>::value_type>::value;
+
+    }  // namespace PdqDetail
+
+}  // namespace Sorting
+#include "PdqSort.tpp"
+#endif
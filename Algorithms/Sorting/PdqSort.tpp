@@ -0,0 +1,372 @@
+// PdqSort.tpp
+#include "PdqSort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace Sorting {
+
+    namespace PdqDetail {
+
+        constexpr std::ptrdiff_t insertionSortThreshold = 24;  // Ranges below this go to insertion sort
+        constexpr std::ptrdiff_t nintherThreshold = 128;       // Ranges above this pick the pivot by pseudo ninther
+        constexpr std::size_t partialInsertionLimit = 8;       // Moves a partial insertion sort may make before giving up
+        constexpr std::size_t blockSize = 64;                  // Offsets buffered per side by the block partition
+        constexpr std::size_t cachelineSize = 64;
+
+        template <typename Iterator>
+        using ValueOf = typename std::iterator_traits<Iterator>::value_type;
+
+        inline int floorLog2(std::size_t n) {
+            int log = 0;
+            while (n >>= 1) {
+                ++log;
+            }
+            return log;
+        }
+
+        template <typename Iterator, typename Compare>
+        void insertionSort(Iterator first, Iterator last, Compare& comp) {
+            if (first == last) {
+                return;
+            }
+            for (Iterator current = first + 1; current != last; ++current) {
+                Iterator sift = current;
+                Iterator previous = current - 1;
+                if (comp(*sift, *previous)) {
+                    ValueOf<Iterator> moving = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*previous);
+                    } while (sift != first && comp(moving, *--previous));
+                    *sift = std::move(moving);
+                }
+            }
+        }
+
+        // Requires *(first - 1) to be no greater than any element of the range, so the sift needs no bounds check
+        template <typename Iterator, typename Compare>
+        void unguardedInsertionSort(Iterator first, Iterator last, Compare& comp) {
+            if (first == last) {
+                return;
+            }
+            for (Iterator current = first + 1; current != last; ++current) {
+                Iterator sift = current;
+                Iterator previous = current - 1;
+                if (comp(*sift, *previous)) {
+                    ValueOf<Iterator> moving = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*previous);
+                    } while (comp(moving, *--previous));
+                    *sift = std::move(moving);
+                }
+            }
+        }
+
+        // Insertion sort that gives up once it has moved more than partialInsertionLimit elements; returns whether
+        // the range ended up sorted
+        template <typename Iterator, typename Compare>
+        bool partialInsertionSort(Iterator first, Iterator last, Compare& comp) {
+            if (first == last) {
+                return true;
+            }
+            std::size_t moves = 0;
+            for (Iterator current = first + 1; current != last; ++current) {
+                Iterator sift = current;
+                Iterator previous = current - 1;
+                if (comp(*sift, *previous)) {
+                    ValueOf<Iterator> moving = std::move(*sift);
+                    do {
+                        *sift-- = std::move(*previous);
+                    } while (sift != first && comp(moving, *--previous));
+                    *sift = std::move(moving);
+                    moves += static_cast<std::size_t>(current - sift);
+                    if (moves > partialInsertionLimit) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        template <typename Iterator, typename Compare>
+        void sort2(Iterator a, Iterator b, Compare& comp) {
+            if (comp(*b, *a)) {
+                std::iter_swap(a, b);
+            }
+        }
+
+        // Leaves the median of the three in b
+        template <typename Iterator, typename Compare>
+        void sort3(Iterator a, Iterator b, Iterator c, Compare& comp) {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        inline unsigned char* alignToCacheline(unsigned char* pointer) {
+            const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+            return pointer + ((cachelineSize - address % cachelineSize) % cachelineSize);
+        }
+
+        // Exchanges first[leftOffsets[i]] with last[-rightOffsets[i]] for every i. Unless the two sides have equally
+        // many misplaced elements, a cyclic permutation does the same with one move per element instead of three.
+        template <typename Iterator>
+        void swapOffsets(Iterator first, Iterator last, const unsigned char* leftOffsets, const unsigned char* rightOffsets,
+                         std::size_t count, bool useSwaps) {
+            if (useSwaps) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    std::iter_swap(first + leftOffsets[i], last - rightOffsets[i]);
+                }
+            } else if (count > 0) {
+                Iterator left = first + leftOffsets[0];
+                Iterator right = last - rightOffsets[0];
+                ValueOf<Iterator> held(std::move(*left));
+                *left = std::move(*right);
+                for (std::size_t i = 1; i < count; ++i) {
+                    left = first + leftOffsets[i];
+                    *right = std::move(*left);
+                    right = last - rightOffsets[i];
+                    *left = std::move(*right);
+                }
+                *right = std::move(held);
+            }
+        }
+
+        // Partitions around *first: smaller elements go left of the returned pivot position, the rest right. The
+        // flag reports that no element had to move, a hint that the range may already be sorted. Needs a median of
+        // three at first so the scans stop without bounds checks.
+        template <typename Iterator, typename Compare>
+        std::pair<Iterator, bool> partitionRight(Iterator begin, Iterator end, Compare& comp) {
+            ValueOf<Iterator> pivot(std::move(*begin));
+            Iterator first = begin;
+            Iterator last = end;
+            while (comp(*++first, pivot)) {
+            }
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot)) {
+                }
+            } else {
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            const bool alreadyPartitioned = first >= last;
+            while (first < last) {
+                std::iter_swap(first, last);
+                while (comp(*++first, pivot)) {
+                }
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            Iterator pivotPosition = first - 1;
+            *begin = std::move(*pivotPosition);
+            *pivotPosition = std::move(pivot);
+            return {pivotPosition, alreadyPartitioned};
+        }
+
+        // partitionRight with the scans replaced by blocks of branch-free comparisons
+        template <typename Iterator, typename Compare>
+        std::pair<Iterator, bool> partitionRightBranchless(Iterator begin, Iterator end, Compare& comp) {
+            ValueOf<Iterator> pivot(std::move(*begin));
+            Iterator first = begin;
+            Iterator last = end;
+            while (comp(*++first, pivot)) {
+            }
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot)) {
+                }
+            } else {
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            const bool alreadyPartitioned = first >= last;
+            if (!alreadyPartitioned) {
+                std::iter_swap(first, last);
+                ++first;
+
+                unsigned char leftStorage[blockSize + cachelineSize];
+                unsigned char rightStorage[blockSize + cachelineSize];
+                unsigned char* leftOffsets = alignToCacheline(leftStorage);
+                unsigned char* rightOffsets = alignToCacheline(rightStorage);
+                Iterator leftBase = first;
+                Iterator rightBase = last;
+                std::size_t leftCount = 0, rightCount = 0, leftStart = 0, rightStart = 0;
+
+                while (first < last) {
+                    // Refill whichever buffers are empty, splitting the unscanned elements when both are
+                    const auto unknown = static_cast<std::size_t>(last - first);
+                    const std::size_t leftSplit = leftCount == 0 ? (rightCount == 0 ? unknown / 2 : unknown) : 0;
+                    const std::size_t rightSplit = rightCount == 0 ? unknown - leftSplit : 0;
+
+                    const std::size_t leftScan = std::min(leftSplit, blockSize);
+                    for (std::size_t i = 0; i < leftScan; ++i) {
+                        leftOffsets[leftCount] = static_cast<unsigned char>(i);
+                        leftCount += !comp(*first, pivot);
+                        ++first;
+                    }
+                    const std::size_t rightScan = std::min(rightSplit, blockSize);
+                    for (std::size_t i = 1; i <= rightScan; ++i) {
+                        rightOffsets[rightCount] = static_cast<unsigned char>(i);
+                        rightCount += comp(*--last, pivot);
+                    }
+
+                    const std::size_t swaps = std::min(leftCount, rightCount);
+                    swapOffsets(leftBase, rightBase, leftOffsets + leftStart, rightOffsets + rightStart, swaps, leftCount == rightCount);
+                    leftCount -= swaps;
+                    rightCount -= swaps;
+                    leftStart += swaps;
+                    rightStart += swaps;
+                    if (leftCount == 0) {
+                        leftStart = 0;
+                        leftBase = first;
+                    }
+                    if (rightCount == 0) {
+                        rightStart = 0;
+                        rightBase = last;
+                    }
+                }
+
+                // At most one side still holds misplaced elements; move them next to the boundary
+                if (leftCount != 0) {
+                    leftOffsets += leftStart;
+                    while (leftCount-- != 0) {
+                        std::iter_swap(leftBase + leftOffsets[leftCount], --last);
+                    }
+                    first = last;
+                }
+                if (rightCount != 0) {
+                    rightOffsets += rightStart;
+                    while (rightCount-- != 0) {
+                        std::iter_swap(rightBase - rightOffsets[rightCount], first);
+                        ++first;
+                    }
+                    last = first;
+                }
+            }
+            Iterator pivotPosition = first - 1;
+            *begin = std::move(*pivotPosition);
+            *pivotPosition = std::move(pivot);
+            return {pivotPosition, alreadyPartitioned};
+        }
+
+        // Puts elements equal to the pivot on its left. Used when the pivot equals the element just before the
+        // range, which was an earlier pivot: everything equal to it is then already in its final place.
+        template <typename Iterator, typename Compare>
+        Iterator partitionLeft(Iterator begin, Iterator end, Compare& comp) {
+            ValueOf<Iterator> pivot(std::move(*begin));
+            Iterator first = begin;
+            Iterator last = end;
+            while (comp(pivot, *--last)) {
+            }
+            if (last + 1 == end) {
+                while (first < last && !comp(pivot, *++first)) {
+                }
+            } else {
+                while (!comp(pivot, *++first)) {
+                }
+            }
+            while (first < last) {
+                std::iter_swap(first, last);
+                while (comp(pivot, *--last)) {
+                }
+                while (!comp(pivot, *++first)) {
+                }
+            }
+            *begin = std::move(*last);
+            *last = std::move(pivot);
+            return last;
+        }
+
+        // leftmost is false when the element before begin bounds the range from below
+        template <bool Branchless, typename Iterator, typename Compare>
+        void sortLoop(Iterator begin, Iterator end, Compare& comp, int badPivotsAllowed, bool leftmost) {
+            using Difference = typename std::iterator_traits<Iterator>::difference_type;
+            while (true) {
+                const Difference size = end - begin;
+                if (size < insertionSortThreshold) {
+                    if (leftmost) {
+                        insertionSort(begin, end, comp);
+                    } else {
+                        unguardedInsertionSort(begin, end, comp);
+                    }
+                    return;
+                }
+
+                const Difference half = size / 2;
+                if (size > nintherThreshold) {
+                    sort3(begin, begin + half, end - 1, comp);
+                    sort3(begin + 1, begin + (half - 1), end - 2, comp);
+                    sort3(begin + 2, begin + (half + 1), end - 3, comp);
+                    sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+                    std::iter_swap(begin, begin + half);
+                } else {
+                    sort3(begin + half, begin, end - 1, comp);
+                }
+
+                if (!leftmost && !comp(*(begin - 1), *begin)) {
+                    begin = partitionLeft(begin, end, comp) + 1;
+                    continue;
+                }
+
+                const auto [pivotPosition, alreadyPartitioned] = Branchless ? partitionRightBranchless(begin, end, comp)
+                                                                            : partitionRight(begin, end, comp);
+                const Difference leftSize = pivotPosition - begin;
+                const Difference rightSize = end - (pivotPosition + 1);
+                if (leftSize < size / 8 || rightSize < size / 8) {
+                    if (--badPivotsAllowed == 0) {
+                        std::make_heap(begin, end, comp);
+                        std::sort_heap(begin, end, comp);
+                        return;
+                    }
+                    // Swap a few elements away from the ends so the next pivots differ
+                    if (leftSize >= insertionSortThreshold) {
+                        std::iter_swap(begin, begin + leftSize / 4);
+                        std::iter_swap(pivotPosition - 1, pivotPosition - leftSize / 4);
+                        if (leftSize > nintherThreshold) {
+                            std::iter_swap(begin + 1, begin + (leftSize / 4 + 1));
+                            std::iter_swap(begin + 2, begin + (leftSize / 4 + 2));
+                            std::iter_swap(pivotPosition - 2, pivotPosition - (leftSize / 4 + 1));
+                            std::iter_swap(pivotPosition - 3, pivotPosition - (leftSize / 4 + 2));
+                        }
+                    }
+                    if (rightSize >= insertionSortThreshold) {
+                        std::iter_swap(pivotPosition + 1, pivotPosition + (1 + rightSize / 4));
+                        std::iter_swap(end - 1, end - rightSize / 4);
+                        if (rightSize > nintherThreshold) {
+                            std::iter_swap(pivotPosition + 2, pivotPosition + (2 + rightSize / 4));
+                            std::iter_swap(pivotPosition + 3, pivotPosition + (3 + rightSize / 4));
+                            std::iter_swap(end - 2, end - (1 + rightSize / 4));
+                            std::iter_swap(end - 3, end - (2 + rightSize / 4));
+                        }
+                    }
+                } else if (alreadyPartitioned && partialInsertionSort(begin, pivotPosition, comp)
+                           && partialInsertionSort(pivotPosition + 1, end, comp)) {
+                    return;
+                }
+
+                sortLoop<Branchless>(begin, pivotPosition, comp, badPivotsAllowed, leftmost);
+                begin = pivotPosition + 1;
+                leftmost = false;
+            }
+        }
+
+    }  // namespace PdqDetail
+
+    template <typename Iterator, typename Compare>
+    void pdqsort(Iterator first, Iterator last, Compare comp) {
+        if (last - first < 2) {
+            return;
+        }
+        PdqDetail::sortLoop<PdqDetail::prefersBranchless<Iterator, Compare>>(
+                first, last, comp, PdqDetail::floorLog2(static_cast<std::size_t>(last - first)), true);
+    }
+
+    template <typename Iterator, typename Compare>
+    void pdqsortBranchless(Iterator first, Iterator last, Compare comp) {
+        if (last - first < 2) {
+            return;
+        }
+        PdqDetail::sortLoop<true>(first, last, comp, PdqDetail::floorLog2(static_cast<std::size_t>(last - first)), true);
+    }
+
+}  // namespace Sorting
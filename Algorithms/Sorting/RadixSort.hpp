@@ -0,0 +1,42 @@
+// Created by Aaron H 5/28/24
+#ifndef RADIXSORT_HPP
+#define RADIXSORT_HPP
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+namespace Sorting {
+
+    // Orders elements by an unsigned integer key, keyOf(element), one byte per pass. Signed keys must be mapped
+    // first, e.g. by flipping the sign bit; a record sorted by (source, destination) can use (source << 32) | destination.
+
+    // LSD radix sort: stable, O(n) per key byte plus a buffer of n elements (which must be default-constructible).
+    // Bytes that are equal across the whole input cost no pass, so small keys in a wide type stay cheap, and input
+    // already in key order is left as it is after the histogram pass.
+    template <typename Iterator, typename KeyOf>
+    void radixSort(Iterator first, Iterator last, KeyOf keyOf);
+
+    template <typename Iterator>
+    void radixSort(Iterator first, Iterator last) {
+        radixSort(first, last, [](const auto& value) { return value; });
+    }
+
+    // MSD radix sort in place (American flag sort): not stable and needs no buffer. Each byte splits a range into
+    // up to 256 buckets that recurse on the next byte; small buckets are finished by pdqsort.
+    template <typename Iterator, typename KeyOf>
+    void inPlaceRadixSort(Iterator first, Iterator last, KeyOf keyOf);
+
+    template <typename Iterator>
+    void inPlaceRadixSort(Iterator first, Iterator last) {
+        inPlaceRadixSort(first, last, [](const auto& value) { return value; });
+    }
+
+    namespace RadixDetail {
+
+        template <typename Iterator, typename KeyOf>
+        using KeyType = std::decay_t<decltype(std::declval<KeyOf&>()(*std::declval<Iterator&>()))>;
+
+    }  // namespace RadixDetail
+
+}  // namespace Sorting
+#include "RadixSort.tpp"
+#endif
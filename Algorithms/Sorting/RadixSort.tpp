@@ -0,0 +1,157 @@
+// RadixSort.tpp
+#include "RadixSort.hpp"
+#include "PdqSort.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+namespace Sorting {
+
+    namespace RadixDetail {
+
+        constexpr std::size_t radix = 256;
+        // Below this many elements a comparison sort beats clearing and scanning the counters
+        constexpr std::ptrdiff_t smallRange = 64;
+
+        using Counts = std::array<std::size_t, radix>;
+
+        template <typename Key>
+        std::size_t digit(Key key, unsigned byte) {
+            return static_cast<std::size_t>((key >> (8 * byte)) & 0xff);
+        }
+
+        // Counts[d] becomes the first position of digit d
+        inline void exclusivePrefix(Counts& counts) {
+            std::size_t sum = 0;
+            for (std::size_t& count : counts) {
+                const std::size_t next = sum + count;
+                count = sum;
+                sum = next;
+            }
+        }
+
+        template <typename Iterator, typename KeyOf>
+        void americanFlagSort(Iterator first, Iterator last, KeyOf& keyOf, unsigned byte) {
+            auto keyLess = [&keyOf](const auto& a, const auto& b) { return keyOf(a) < keyOf(b); };
+            while (true) {
+                const auto size = static_cast<std::size_t>(last - first);
+                if (static_cast<std::ptrdiff_t>(size) < smallRange) {
+                    pdqsort(first, last, keyLess);
+                    return;
+                }
+                Counts counts{};
+                for (Iterator it = first; it != last; ++it) {
+                    ++counts[digit(keyOf(*it), byte)];
+                }
+                if (std::find(counts.begin(), counts.end(), size) != counts.end()) {
+                    // A single bucket: nothing moves at this byte
+                    if (byte == 0) {
+                        return;
+                    }
+                    --byte;
+                    continue;
+                }
+
+                Counts heads = counts;
+                exclusivePrefix(heads);
+                Counts ends;
+                for (std::size_t d = 0; d < radix; ++d) {
+                    ends[d] = heads[d] + counts[d];
+                }
+                // Every swap sends one element straight to the next free slot of its bucket
+                for (std::size_t d = 0; d < radix; ++d) {
+                    while (heads[d] < ends[d]) {
+                        const std::size_t target = digit(keyOf(first[heads[d]]), byte);
+                        if (target == d) {
+                            ++heads[d];
+                        } else {
+                            std::iter_swap(first + heads[d], first + heads[target]++);
+                        }
+                    }
+                }
+                if (byte == 0) {
+                    return;
+                }
+                for (std::size_t d = 0; d < radix; ++d) {
+                    if (counts[d] > 1) {
+                        americanFlagSort(first + (ends[d] - counts[d]), first + ends[d], keyOf, byte - 1);
+                    }
+                }
+                return;
+            }
+        }
+
+    }  // namespace RadixDetail
+
+    template <typename Iterator, typename KeyOf>
+    void radixSort(Iterator first, Iterator last, KeyOf keyOf) {
+        using Value = typename std::iterator_traits<Iterator>::value_type;
+        using Key = RadixDetail::KeyType<Iterator, KeyOf>;
+        static_assert(std::is_integral_v<Key> && std::is_unsigned_v<Key>, "Radix sort needs an unsigned integer key");
+        constexpr unsigned bytes = sizeof(Key);
+
+        const auto size = static_cast<std::size_t>(last - first);
+        if (static_cast<std::ptrdiff_t>(size) < RadixDetail::smallRange) {
+            // Insertion sort is stable, matching the radix passes
+            auto keyLess = [&keyOf](const auto& a, const auto& b) { return keyOf(a) < keyOf(b); };
+            PdqDetail::insertionSort(first, last, keyLess);
+            return;
+        }
+
+        // One read of the input histograms every byte and notices input that is already in order
+        std::array<RadixDetail::Counts, bytes> counts{};
+        Key previous = 0;
+        bool sorted = true;
+        for (Iterator it = first; it != last; ++it) {
+            const Key key = keyOf(*it);
+            sorted &= previous <= key;
+            previous = key;
+            for (unsigned byte = 0; byte < bytes; ++byte) {
+                ++counts[byte][RadixDetail::digit(key, byte)];
+            }
+        }
+        if (sorted) {
+            return;
+        }
+
+        std::vector<Value> buffer;
+        bool inBuffer = false;
+        auto scatter = [&keyOf](auto from, auto to, auto out, RadixDetail::Counts& offsets, unsigned byte) {
+            for (; from != to; ++from) {
+                out[offsets[RadixDetail::digit(keyOf(*from), byte)]++] = std::move(*from);
+            }
+        };
+        for (unsigned byte = 0; byte < bytes; ++byte) {
+            RadixDetail::Counts& offsets = counts[byte];
+            if (std::find(offsets.begin(), offsets.end(), size) != offsets.end()) {
+                continue;
+            }
+            if (buffer.empty()) {
+                buffer.resize(size);
+            }
+            RadixDetail::exclusivePrefix(offsets);
+            if (inBuffer) {
+                scatter(buffer.begin(), buffer.end(), first, offsets, byte);
+            } else {
+                scatter(first, last, buffer.begin(), offsets, byte);
+            }
+            inBuffer = !inBuffer;
+        }
+        if (inBuffer) {
+            std::move(buffer.begin(), buffer.end(), first);
+        }
+    }
+
+    template <typename Iterator, typename KeyOf>
+    void inPlaceRadixSort(Iterator first, Iterator last, KeyOf keyOf) {
+        using Key = RadixDetail::KeyType<Iterator, KeyOf>;
+        static_assert(std::is_integral_v<Key> && std::is_unsigned_v<Key>, "Radix sort needs an unsigned integer key");
+        if (last - first < 2) {
+            return;
+        }
+        RadixDetail::americanFlagSort(first, last, keyOf, sizeof(Key) - 1);
+    }
+
+}  // namespace Sorting
@@ -0,0 +1,21 @@
+// Created by Aaron H 5/28/24
+#ifndef SAMPLESORT_HPP
+#define SAMPLESORT_HPP
+#include "../Parallel/ParallelFor.hpp"
+#include <cstddef>
+#include <functional>
+namespace Sorting {
+
+    // Parallel sample sort. A sorted random sample yields splitters that cut the key range into buckets of about
+    // equal size; threads classify slices of the input against a branch-free splitter tree and scatter the elements
+    // bucket by bucket into a buffer, then sort the buckets with pdqsort, largest first, and move them back. Ranges
+    // below parallelSortThreshold, or a single thread, go straight to pdqsort. Not stable; elements must be copyable
+    // and default-constructible, and comp must be safe to call from several threads at once.
+    template <typename Iterator, typename Compare = std::less<>>
+    void sampleSort(Iterator first, Iterator last, Compare comp = Compare(), unsigned threads = Parallel::defaultThreadCount());
+
+    constexpr std::size_t parallelSortThreshold = std::size_t{1} << 16;
+
+}  // namespace Sorting
+#include "SampleSort.tpp"
+#endif
@@ -0,0 +1,147 @@
+// SampleSort.tpp
+#include "SampleSort.hpp"
+#include "PdqSort.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace Sorting {
+
+    namespace SampleDetail {
+
+        constexpr std::size_t oversampling = 16;  // Sampled elements per bucket; more gives evener buckets
+        constexpr unsigned maxBucketBits = 8;     // Bucket ids fit a byte
+        constexpr std::size_t blocksPerThread = 4;
+
+        // The splitters as an implicit binary search tree (node i has children 2i and 2i + 1), so classifying an
+        // element is a fixed number of steps whose direction is computed rather than branched on
+        template <typename Value, typename Compare>
+        class SplitterTree {
+        public:
+            SplitterTree(const std::vector<Value>& splitters, unsigned levels, const Compare& comp)
+                    : nodes(std::size_t{1} << levels), levels(levels), comp(comp) {
+                std::size_t next = 0;
+                fill(1, splitters, next);
+            }
+
+            // Bucket b holds the elements x with splitter[b - 1] <= x < splitter[b]
+            [[nodiscard]] std::uint8_t bucketOf(const Value& value) const {
+                std::size_t node = 1;
+                for (unsigned level = 0; level < levels; ++level) {
+                    node = 2 * node + static_cast<std::size_t>(!comp(value, nodes[node]));
+                }
+                return static_cast<std::uint8_t>(node - nodes.size());
+            }
+
+        private:
+            std::vector<Value> nodes;  // nodes[0] is unused
+            unsigned levels;
+            const Compare& comp;
+
+            // In-order traversal hands out the sorted splitters
+            void fill(std::size_t node, const std::vector<Value>& splitters, std::size_t& next) {
+                if (node >= nodes.size()) {
+                    return;
+                }
+                fill(2 * node, splitters, next);
+                nodes[node] = splitters[next++];
+                fill(2 * node + 1, splitters, next);
+            }
+        };
+
+    }  // namespace SampleDetail
+
+    template <typename Iterator, typename Compare>
+    void sampleSort(Iterator first, Iterator last, Compare comp, unsigned threads) {
+        using Value = typename std::iterator_traits<Iterator>::value_type;
+        const auto size = static_cast<std::size_t>(last - first);
+        if (threads <= 1 || size < parallelSortThreshold) {
+            pdqsort(first, last, comp);
+            return;
+        }
+
+        // A few buckets per thread lets the bucket sorts balance when the sample misjudges a bucket
+        unsigned bucketBits = 1;
+        while ((std::size_t{1} << bucketBits) < SampleDetail::blocksPerThread * threads && bucketBits < SampleDetail::maxBucketBits) {
+            ++bucketBits;
+        }
+        const std::size_t buckets = std::size_t{1} << bucketBits;
+
+        std::vector<Value> sample;
+        sample.reserve(buckets * SampleDetail::oversampling);
+        std::mt19937_64 rng(size);
+        std::uniform_int_distribution<std::size_t> pick(0, size - 1);
+        for (std::size_t i = 0; i < buckets * SampleDetail::oversampling; ++i) {
+            sample.push_back(first[pick(rng)]);
+        }
+        pdqsort(sample.begin(), sample.end(), comp);
+        std::vector<Value> splitters;
+        splitters.reserve(buckets - 1);
+        for (std::size_t bucket = 1; bucket < buckets; ++bucket) {
+            splitters.push_back(sample[bucket * SampleDetail::oversampling]);
+        }
+        const SampleDetail::SplitterTree<Value, Compare> tree(splitters, bucketBits, comp);
+
+        // Classify: each block counts its elements per bucket and remembers every element's bucket
+        const std::size_t blocks = SampleDetail::blocksPerThread * threads;
+        const std::size_t blockLength = (size + blocks - 1) / blocks;
+        std::vector<std::uint8_t> bucketIds(size);
+        std::vector<std::size_t> cursors(blocks * buckets, 0);
+        Parallel::parallelFor(0, blocks, 1, threads, [&](unsigned, std::size_t blockBegin, std::size_t blockEnd) {
+            for (std::size_t block = blockBegin; block < blockEnd; ++block) {
+                std::size_t* counts = cursors.data() + block * buckets;
+                const std::size_t end = std::min(size, (block + 1) * blockLength);
+                for (std::size_t i = block * blockLength; i < end; ++i) {
+                    const std::uint8_t bucket = tree.bucketOf(first[i]);
+                    bucketIds[i] = bucket;
+                    ++counts[bucket];
+                }
+            }
+        });
+
+        // Bucket-major prefix sums turn each block's counts into its write cursors
+        std::vector<std::size_t> bucketStart(buckets + 1);
+        std::size_t running = 0;
+        for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+            bucketStart[bucket] = running;
+            for (std::size_t block = 0; block < blocks; ++block) {
+                const std::size_t count = cursors[block * buckets + bucket];
+                cursors[block * buckets + bucket] = running;
+                running += count;
+            }
+        }
+        bucketStart[buckets] = running;
+
+        std::vector<Value> buffer(size);
+        Parallel::parallelFor(0, blocks, 1, threads, [&](unsigned, std::size_t blockBegin, std::size_t blockEnd) {
+            for (std::size_t block = blockBegin; block < blockEnd; ++block) {
+                std::size_t* cursor = cursors.data() + block * buckets;
+                const std::size_t end = std::min(size, (block + 1) * blockLength);
+                for (std::size_t i = block * blockLength; i < end; ++i) {
+                    buffer[cursor[bucketIds[i]]++] = std::move(first[i]);
+                }
+            }
+        });
+
+        std::vector<std::size_t> bySize(buckets);
+        for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+            bySize[bucket] = bucket;
+        }
+        std::sort(bySize.begin(), bySize.end(), [&bucketStart](std::size_t a, std::size_t b) {
+            return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+        });
+        Parallel::parallelFor(0, buckets, 1, threads, [&](unsigned, std::size_t rankBegin, std::size_t rankEnd) {
+            for (std::size_t rank = rankBegin; rank < rankEnd; ++rank) {
+                const std::size_t bucket = bySize[rank];
+                auto bucketBegin = buffer.begin() + static_cast<std::ptrdiff_t>(bucketStart[bucket]);
+                auto bucketEnd = buffer.begin() + static_cast<std::ptrdiff_t>(bucketStart[bucket + 1]);
+                pdqsort(bucketBegin, bucketEnd, comp);
+                std::move(bucketBegin, bucketEnd, first + static_cast<std::ptrdiff_t>(bucketStart[bucket]));
+            }
+        });
+    }
+
+}  // namespace Sorting
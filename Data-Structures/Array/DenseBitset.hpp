@@ -0,0 +1,44 @@
+// Created by Aaron H on 5/28/24.
+#ifndef DENSEBITSET_HPP
+#define DENSEBITSET_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Visited-style flags over dense ids, one bit each in 64-bit words: an eighth of a byte array and a tiny fraction of
+// a hash set of vertices. Unlike std::vector<bool> it hands out no proxies and clears a word at a time.
+class DenseBitset {
+public:
+    DenseBitset() = default;
+    explicit DenseBitset(std::size_t bits) : words((bits + 63) / 64, 0), bits(bits) {}
+
+    [[nodiscard]] bool test(std::size_t index) const { return words[index >> 6] >> (index & 63) & 1; }
+    void set(std::size_t index) { words[index >> 6] |= std::uint64_t{1} << (index & 63); }
+    void reset(std::size_t index) { words[index >> 6] &= ~(std::uint64_t{1} << (index & 63)); }
+    // Sets the bit and reports whether it was already set, so a visit check costs one word access
+    bool testAndSet(std::size_t index) {
+        std::uint64_t& word = words[index >> 6];
+        const std::uint64_t mask = std::uint64_t{1} << (index & 63);
+        const bool was = (word & mask) != 0;
+        word |= mask;
+        return was;
+    }
+
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+    // New bits start cleared
+    void resize(std::size_t count) {
+        words.resize((count + 63) / 64, 0);
+        if (count < bits && (count & 63) != 0) {
+            words.back() &= (std::uint64_t{1} << (count & 63)) - 1;
+        }
+        bits = count;
+    }
+    [[nodiscard]] std::size_t size() const { return bits; }
+
+private:
+    std::vector<std::uint64_t> words;
+    std::size_t bits = 0;
+};
+#endif
@@ -0,0 +1,247 @@
+// Created by Aaron H on 5/28/24.
+#ifndef FLATHASHMAP_HPP
+#define FLATHASHMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace FlatHashDetail {
+
+    // One control byte per slot: Empty, Deleted (a tombstone) or, for a full slot, the low 7 bits of its hash
+    using ControlByte = std::int8_t;
+    constexpr ControlByte Empty = -128;
+    constexpr ControlByte Deleted = -2;
+
+    // Sixteen control bytes examined at once; every match is a bitmask with bit i set for byte i
+    class Group {
+    public:
+        static constexpr std::size_t width = 16;
+
+#if defined(__SSE2__)
+        explicit Group(const ControlByte* position) : bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(position))) {}
+
+        [[nodiscard]] std::uint32_t match(ControlByte fingerprint) const {
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(fingerprint))));
+        }
+        [[nodiscard]] std::uint32_t matchEmpty() const { return match(Empty); }
+        // Full slots have the sign bit clear, Empty and Deleted have it set
+        [[nodiscard]] std::uint32_t matchNonFull() const { return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes)); }
+
+    private:
+        __m128i bytes;
+#else
+        explicit Group(const ControlByte* position) {
+            for (std::size_t i = 0; i < width; ++i) {
+                bytes[i] = position[i];
+            }
+        }
+
+        [[nodiscard]] std::uint32_t match(ControlByte fingerprint) const {
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < width; ++i) {
+                mask |= static_cast<std::uint32_t>(bytes[i] == fingerprint) << i;
+            }
+            return mask;
+        }
+        [[nodiscard]] std::uint32_t matchEmpty() const { return match(Empty); }
+        [[nodiscard]] std::uint32_t matchNonFull() const {
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < width; ++i) {
+                mask |= static_cast<std::uint32_t>(bytes[i] < 0) << i;
+            }
+            return mask;
+        }
+
+    private:
+        ControlByte bytes[width];
+#endif
+    };
+
+    // Murmur3's finalizer, so identity hashes such as std::hash<int> still spread over both fingerprint and position
+    inline std::uint64_t mix(std::uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+}  // namespace FlatHashDetail
+
+// Open-addressing hash map in the Swiss-table layout: a flat array of control bytes probed sixteen at a time with
+// SIMD compares, and keys and values stored inline in a parallel slot array, so a lookup usually costs one cache
+// miss for the control group and one for the slot. Erasing leaves a tombstone; tombstones are purged when the table
+// rehashes. The maximum load factor is 7/8. Any insertion or erase-triggered rehash invalidates iterators and
+// references, unlike std::unordered_map.
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+         typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class FlatHashMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = Allocator;
+
+    template<bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+        Iterator() = default;
+        // Lets iterator convert to const_iterator
+        template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) : ctrl(other.ctrl), slot(other.slot), end(other.end) {}
+
+        reference operator*() const { return *slot; }
+        pointer operator->() const { return slot; }
+        Iterator& operator++() { ++ctrl; ++slot; skipNonFull(); return *this; }
+        Iterator operator++(int) { Iterator copy = *this; ++*this; return copy; }
+        bool operator==(const Iterator& other) const { return ctrl == other.ctrl; }
+        bool operator!=(const Iterator& other) const { return ctrl != other.ctrl; }
+
+    private:
+        friend class FlatHashMap;
+        template<bool> friend class Iterator;
+
+        Iterator(const FlatHashDetail::ControlByte* ctrl, pointer slot, const FlatHashDetail::ControlByte* end)
+                : ctrl(ctrl), slot(slot), end(end) { skipNonFull(); }
+        void skipNonFull() {
+            while (ctrl != end && *ctrl < 0) {
+                ++ctrl;
+                ++slot;
+            }
+        }
+
+        const FlatHashDetail::ControlByte* ctrl = nullptr;
+        pointer slot = nullptr;
+        const FlatHashDetail::ControlByte* end = nullptr;
+    };
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+    explicit FlatHashMap(const Allocator& allocator) : slotAllocator(allocator) {}
+    explicit FlatHashMap(size_type capacity, const Allocator& allocator = Allocator()) : slotAllocator(allocator) { reserve(capacity); }
+    FlatHashMap(const FlatHashMap& other);
+    FlatHashMap(FlatHashMap&& other) noexcept;
+    // Allocator-extended forms, so the map can nest inside pmr containers
+    FlatHashMap(const FlatHashMap& other, const Allocator& allocator);
+    FlatHashMap(FlatHashMap&& other, const Allocator& allocator);
+    FlatHashMap& operator=(const FlatHashMap& other);
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept(SlotTraits::is_always_equal::value);
+    ~FlatHashMap();
+
+    iterator begin() { return iterator(ctrl, slots, ctrl + slotCount); }
+    iterator end() { return iterator(ctrl + slotCount, slots + slotCount, ctrl + slotCount); }
+    const_iterator begin() const { return const_iterator(ctrl, slots, ctrl + slotCount); }
+    const_iterator end() const { return const_iterator(ctrl + slotCount, slots + slotCount, ctrl + slotCount); }
+
+    [[nodiscard]] bool empty() const { return elements == 0; }
+    [[nodiscard]] size_type size() const { return elements; }
+    [[nodiscard]] size_type capacity() const { return slotCount; }
+    [[nodiscard]] allocator_type get_allocator() const { return slotAllocator; }
+
+    iterator find(const Key& key);
+    const_iterator find(const Key& key) const;
+    [[nodiscard]] bool contains(const Key& key) const { return findIndex(key) != npos; }
+    [[nodiscard]] size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    Value& at(const Key& key);
+    const Value& at(const Key& key) const;
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+    template<typename... Args>
+    std::pair<iterator, bool> emplace(const Key& key, Args&&... args) { return try_emplace(key, std::forward<Args>(args)...); }
+    std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+
+    size_type erase(const Key& key);
+    iterator erase(const_iterator position);
+
+    void clear();
+    // Makes room for expected elements without rehashing
+    void reserve(size_type expected);
+
+private:
+    using ControlByte = FlatHashDetail::ControlByte;
+    using Group = FlatHashDetail::Group;
+    using SlotTraits = std::allocator_traits<Allocator>;
+    using ControlAllocator = typename SlotTraits::template rebind_alloc<ControlByte>;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Control bytes carry a copy of the first group after the last slot so a group load never wraps
+    ControlByte* ctrl = nullptr;
+    value_type* slots = nullptr;
+    size_type slotCount = 0;
+    size_type elements = 0;
+    size_type growthLeft = 0;  // Empty slots that may still be filled before the load factor is exceeded
+    Hash hash;
+    KeyEqual equal;
+    Allocator slotAllocator;
+
+    static size_type maxLoad(size_type capacity) { return capacity - capacity / 8; }
+    std::uint64_t hashOf(const Key& key) const { return FlatHashDetail::mix(static_cast<std::uint64_t>(hash(key))); }
+    size_type findIndex(const Key& key) const;
+    size_type findNonFull(std::uint64_t hashValue) const;
+    void setControl(size_type index, ControlByte value);
+    void rehash(size_type newCapacity);
+    void destroyAndDeallocate();
+};
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using PmrFlatHashMap = FlatHashMap<Key, Value, Hash, KeyEqual, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+// Membership-only FlatHashMap. The empty value costs at most the key's alignment padding.
+template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>, typename Allocator = std::allocator<Key>>
+class FlatHashSet {
+    struct Present {};
+    using Map = FlatHashMap<Key, Present, Hash, KeyEqual,
+                            typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const Key, Present>>>;
+public:
+    using allocator_type = Allocator;
+
+    FlatHashSet() = default;
+    explicit FlatHashSet(const Allocator& allocator) : map(typename Map::allocator_type(allocator)) {}
+    FlatHashSet(const FlatHashSet& other, const Allocator& allocator) : map(other.map, typename Map::allocator_type(allocator)) {}
+    FlatHashSet(FlatHashSet&& other, const Allocator& allocator) : map(std::move(other.map), typename Map::allocator_type(allocator)) {}
+    FlatHashSet(const FlatHashSet&) = default;
+    FlatHashSet(FlatHashSet&&) noexcept = default;
+    FlatHashSet& operator=(const FlatHashSet&) = default;
+    FlatHashSet& operator=(FlatHashSet&&) = default;  // noexcept exactly when the map's move assignment is
+
+    // Returns whether key was newly added
+    bool insert(const Key& key) { return map.try_emplace(key).second; }
+    std::size_t erase(const Key& key) { return map.erase(key); }
+    [[nodiscard]] bool contains(const Key& key) const { return map.contains(key); }
+    [[nodiscard]] std::size_t size() const { return map.size(); }
+    [[nodiscard]] bool empty() const { return map.empty(); }
+    void reserve(std::size_t expected) { map.reserve(expected); }
+    void clear() { map.clear(); }
+
+private:
+    Map map;
+};
+
+template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using PmrFlatHashSet = FlatHashSet<Key, Hash, KeyEqual, std::pmr::polymorphic_allocator<Key>>;
+
+#include "FlatHashMap.tpp"
+#endif
@@ -0,0 +1,290 @@
+#include "FlatHashMap.hpp"
+#include <algorithm>
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::FlatHashMap(const FlatHashMap& other)
+        : hash(other.hash), equal(other.equal), slotAllocator(SlotTraits::select_on_container_copy_construction(other.slotAllocator)) {
+    reserve(other.elements);
+    for (const auto& entry : other) {
+        try_emplace(entry.first, entry.second);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::FlatHashMap(FlatHashMap&& other) noexcept
+        : ctrl(std::exchange(other.ctrl, nullptr)), slots(std::exchange(other.slots, nullptr)),
+          slotCount(std::exchange(other.slotCount, 0)), elements(std::exchange(other.elements, 0)),
+          growthLeft(std::exchange(other.growthLeft, 0)), hash(std::move(other.hash)), equal(std::move(other.equal)),
+          slotAllocator(std::move(other.slotAllocator)) {}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::FlatHashMap(const FlatHashMap& other, const Allocator& allocator)
+        : hash(other.hash), equal(other.equal), slotAllocator(allocator) {
+    reserve(other.elements);
+    for (const auto& entry : other) {
+        try_emplace(entry.first, entry.second);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::FlatHashMap(FlatHashMap&& other, const Allocator& allocator)
+        : hash(other.hash), equal(other.equal), slotAllocator(allocator) {
+    *this = std::move(other);
+}
+
+// Assignment never propagates the allocator, matching polymorphic_allocator: the target keeps its own storage source.
+// Move assignment is therefore only noexcept for allocators that always compare equal; otherwise it may have to move
+// the elements into freshly allocated storage.
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>& FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::operator=(const FlatHashMap& other) {
+    if (this != &other) {
+        clear();
+        hash = other.hash;
+        equal = other.equal;
+        reserve(other.elements);
+        for (const auto& entry : other) {
+            try_emplace(entry.first, entry.second);
+        }
+    }
+    return *this;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>& FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::operator=(FlatHashMap&& other) noexcept(SlotTraits::is_always_equal::value) {
+    if (this == &other) {
+        return *this;
+    }
+    hash = std::move(other.hash);
+    equal = std::move(other.equal);
+    if (slotAllocator == other.slotAllocator) {
+        destroyAndDeallocate();
+        ctrl = std::exchange(other.ctrl, nullptr);
+        slots = std::exchange(other.slots, nullptr);
+        slotCount = std::exchange(other.slotCount, 0);
+        elements = std::exchange(other.elements, 0);
+        growthLeft = std::exchange(other.growthLeft, 0);
+    } else {
+        // Storage from another allocator cannot be adopted, so the elements move one by one
+        clear();
+        reserve(other.elements);
+        for (auto& entry : other) {
+            try_emplace(entry.first, std::move(entry.second));
+        }
+        other.clear();
+    }
+    return *this;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::~FlatHashMap() {
+    destroyAndDeallocate();
+}
+
+// Triangular probing over groups: offsets 0, 16, 48, 96, ... visit every group once for power-of-two capacities.
+// A group with an Empty byte ends the search, since an insert would have stopped there.
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::findIndex(const Key& key) const {
+    if (elements == 0) {
+        return npos;
+    }
+    const std::uint64_t hashValue = hashOf(key);
+    const auto fingerprint = static_cast<ControlByte>(hashValue & 0x7F);
+    const size_type mask = slotCount - 1;
+    size_type position = static_cast<size_type>(hashValue >> 7) & mask;
+    for (size_type step = Group::width;; step += Group::width) {
+        Group group(ctrl + position);
+        for (std::uint32_t matches = group.match(fingerprint); matches != 0; matches &= matches - 1) {
+            const size_type index = (position + static_cast<size_type>(__builtin_ctz(matches))) & mask;
+            if (equal(slots[index].first, key)) {
+                return index;
+            }
+        }
+        if (group.matchEmpty() != 0) {
+            return npos;
+        }
+        position = (position + step) & mask;
+    }
+}
+
+// First Empty or Deleted slot on the probe sequence of hashValue; the load factor guarantees one exists
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::findNonFull(std::uint64_t hashValue) const {
+    const size_type mask = slotCount - 1;
+    size_type position = static_cast<size_type>(hashValue >> 7) & mask;
+    for (size_type step = Group::width;; step += Group::width) {
+        std::uint32_t free = Group(ctrl + position).matchNonFull();
+        if (free != 0) {
+            return (position + static_cast<size_type>(__builtin_ctz(free))) & mask;
+        }
+        position = (position + step) & mask;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::setControl(size_type index, ControlByte value) {
+    ctrl[index] = value;
+    if (index < Group::width) {
+        ctrl[slotCount + index] = value;
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::iterator FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::find(const Key& key) {
+    size_type index = findIndex(key);
+    return index == npos ? end() : iterator(ctrl + index, slots + index, ctrl + slotCount);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::const_iterator FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::find(const Key& key) const {
+    size_type index = findIndex(key);
+    return index == npos ? end() : const_iterator(ctrl + index, slots + index, ctrl + slotCount);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+Value& FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::at(const Key& key) {
+    size_type index = findIndex(key);
+    if (index == npos) {
+        throw std::out_of_range("Key not found in FlatHashMap");
+    }
+    return slots[index].second;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+const Value& FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::at(const Key& key) const {
+    size_type index = findIndex(key);
+    if (index == npos) {
+        throw std::out_of_range("Key not found in FlatHashMap");
+    }
+    return slots[index].second;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+template<typename... Args>
+std::pair<typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::iterator, bool>
+FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::try_emplace(const Key& key, Args&&... args) {
+    size_type index = findIndex(key);
+    if (index != npos) {
+        return {iterator(ctrl + index, slots + index, ctrl + slotCount), false};
+    }
+    if (slotCount == 0) {
+        rehash(Group::width);
+    }
+    const std::uint64_t hashValue = hashOf(key);
+    index = findNonFull(hashValue);
+    // Reusing a tombstone never costs load, filling an Empty slot does
+    if (growthLeft == 0 && ctrl[index] == FlatHashDetail::Empty) {
+        // Mostly tombstones: purge them in place; otherwise grow
+        rehash(elements < maxLoad(slotCount) / 2 ? slotCount : slotCount * 2);
+        index = findNonFull(hashValue);
+    }
+    SlotTraits::construct(slotAllocator, slots + index, std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    if (ctrl[index] == FlatHashDetail::Empty) {
+        --growthLeft;
+    }
+    setControl(index, static_cast<ControlByte>(hashValue & 0x7F));
+    ++elements;
+    return {iterator(ctrl + index, slots + index, ctrl + slotCount), true};
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::size_type FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::erase(const Key& key) {
+    size_type index = findIndex(key);
+    if (index == npos) {
+        return 0;
+    }
+    SlotTraits::destroy(slotAllocator, slots + index);
+    setControl(index, FlatHashDetail::Deleted);
+    --elements;
+    return 1;
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+typename FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::iterator FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::erase(const_iterator position) {
+    const auto index = static_cast<size_type>(position.ctrl - ctrl);
+    SlotTraits::destroy(slotAllocator, slots + index);
+    setControl(index, FlatHashDetail::Deleted);
+    --elements;
+    return iterator(ctrl + index + 1, slots + index + 1, ctrl + slotCount);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::clear() {
+    if (slotCount == 0) {
+        return;
+    }
+    for (size_type index = 0; index < slotCount; ++index) {
+        if (ctrl[index] >= 0) {
+            SlotTraits::destroy(slotAllocator, slots + index);
+        }
+    }
+    std::fill(ctrl, ctrl + slotCount + Group::width, FlatHashDetail::Empty);
+    elements = 0;
+    growthLeft = maxLoad(slotCount);
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::reserve(size_type expected) {
+    if (expected <= elements + growthLeft && slotCount != 0) {
+        return;
+    }
+    size_type capacity = Group::width;
+    while (maxLoad(capacity) < expected) {
+        capacity *= 2;
+    }
+    if (capacity > slotCount) {
+        rehash(capacity);
+    }
+}
+
+// Moves every element into freshly allocated arrays of newCapacity slots, dropping tombstones on the way
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::rehash(size_type newCapacity) {
+    ControlAllocator controlAllocator(slotAllocator);
+    // Both arrays are allocated before any member changes, so a failed allocation leaves the map as it was
+    ControlByte* newCtrl = std::allocator_traits<ControlAllocator>::allocate(controlAllocator, newCapacity + Group::width);
+    value_type* newSlots;
+    try {
+        newSlots = SlotTraits::allocate(slotAllocator, newCapacity);
+    } catch (...) {
+        std::allocator_traits<ControlAllocator>::deallocate(controlAllocator, newCtrl, newCapacity + Group::width);
+        throw;
+    }
+    ControlByte* oldCtrl = std::exchange(ctrl, newCtrl);
+    value_type* oldSlots = std::exchange(slots, newSlots);
+    const size_type oldCount = std::exchange(slotCount, newCapacity);
+    std::fill(ctrl, ctrl + newCapacity + Group::width, FlatHashDetail::Empty);
+    for (size_type index = 0; index < oldCount; ++index) {
+        if (oldCtrl[index] >= 0) {
+            const std::uint64_t hashValue = hashOf(oldSlots[index].first);
+            const size_type target = findNonFull(hashValue);
+            // The key is const inside the pair, so it is copied while the value moves
+            SlotTraits::construct(slotAllocator, slots + target, std::piecewise_construct, std::forward_as_tuple(oldSlots[index].first),
+                                  std::forward_as_tuple(std::move(oldSlots[index].second)));
+            SlotTraits::destroy(slotAllocator, oldSlots + index);
+            setControl(target, static_cast<ControlByte>(hashValue & 0x7F));
+        }
+    }
+    growthLeft = maxLoad(newCapacity) - elements;
+    if (oldCount != 0) {
+        std::allocator_traits<ControlAllocator>::deallocate(controlAllocator, oldCtrl, oldCount + Group::width);
+        SlotTraits::deallocate(slotAllocator, oldSlots, oldCount);
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename KeyEqual, typename Allocator>
+void FlatHashMap<Key, Value, Hash, KeyEqual, Allocator>::destroyAndDeallocate() {
+    if (slotCount == 0) {
+        return;
+    }
+    clear();
+    ControlAllocator controlAllocator(slotAllocator);
+    std::allocator_traits<ControlAllocator>::deallocate(controlAllocator, ctrl, slotCount + Group::width);
+    SlotTraits::deallocate(slotAllocator, slots, slotCount);
+    ctrl = nullptr;
+    slots = nullptr;
+    slotCount = 0;
+    growthLeft = 0;
+}
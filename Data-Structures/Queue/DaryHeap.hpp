@@ -0,0 +1,111 @@
+// Created by Aaron H on 5/28/24.
+#ifndef DARYHEAP_HPP
+#define DARYHEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Indexed d-ary min-heap over dense ids below the bound given at construction. Each id is queued at most once and a
+// position table turns decrease() into a sift-up instead of a duplicate entry. Four children per node halve the depth
+// of a binary heap and keep a node's children on one cache line.
+// Shared interface of the shortest-path queues: push(id, key) for an id not queued, decrease(id, key) for a queued id
+// and a key no larger than its current one, pop() returning the id with the smallest key.
+template<typename Key, unsigned Arity = 4>
+class DaryHeap {
+    static_assert(Arity >= 2, "A heap node needs at least two children");
+public:
+    using Id = std::uint32_t;
+
+    explicit DaryHeap(std::size_t idBound) : position(idBound, npos) {}
+
+    [[nodiscard]] bool empty() const { return entries.empty(); }
+    [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+    void push(Id id, Key key);
+    void decrease(Id id, Key key);
+    std::pair<Id, Key> pop();
+    // Stale positions are harmless: only queued ids are ever looked up
+    void clear() { entries.clear(); }
+
+private:
+    struct Entry {
+        Key key;
+        Id id;
+    };
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    std::vector<Entry> entries;
+    std::vector<std::size_t> position;
+
+    void siftUp(std::size_t index, Entry entry);
+    void siftDown(std::size_t index, Entry entry);
+};
+
+template<typename Key, unsigned Arity>
+void DaryHeap<Key, Arity>::push(Id id, Key key) {
+    entries.emplace_back();
+    siftUp(entries.size() - 1, Entry{key, id});
+}
+
+template<typename Key, unsigned Arity>
+void DaryHeap<Key, Arity>::decrease(Id id, Key key) {
+    siftUp(position[id], Entry{key, id});
+}
+
+template<typename Key, unsigned Arity>
+std::pair<typename DaryHeap<Key, Arity>::Id, Key> DaryHeap<Key, Arity>::pop() {
+    Entry top = entries.front();
+    Entry last = entries.back();
+    entries.pop_back();
+    if (!entries.empty()) {
+        siftDown(0, last);
+    }
+    position[top.id] = npos;
+    return {top.id, top.key};
+}
+
+// Both sifts carry the moving entry in hand and write it once, at its final slot
+template<typename Key, unsigned Arity>
+void DaryHeap<Key, Arity>::siftUp(std::size_t index, Entry entry) {
+    while (index > 0) {
+        std::size_t parent = (index - 1) / Arity;
+        if (!(entry.key < entries[parent].key)) {
+            break;
+        }
+        entries[index] = entries[parent];
+        position[entries[index].id] = index;
+        index = parent;
+    }
+    entries[index] = entry;
+    position[entry.id] = index;
+}
+
+template<typename Key, unsigned Arity>
+void DaryHeap<Key, Arity>::siftDown(std::size_t index, Entry entry) {
+    const std::size_t count = entries.size();
+    while (true) {
+        std::size_t first = index * Arity + 1;
+        if (first >= count) {
+            break;
+        }
+        std::size_t last = first + Arity < count ? first + Arity : count;
+        std::size_t best = first;
+        for (std::size_t child = first + 1; child < last; ++child) {
+            if (entries[child].key < entries[best].key) {
+                best = child;
+            }
+        }
+        if (!(entries[best].key < entry.key)) {
+            break;
+        }
+        entries[index] = entries[best];
+        position[entries[index].id] = index;
+        index = best;
+    }
+    entries[index] = entry;
+    position[entry.id] = index;
+}
+#endif
@@ -0,0 +1,129 @@
+// Created by Aaron H on 5/28/24.
+#ifndef PAIRINGHEAP_HPP
+#define PAIRINGHEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Pairing heap over dense ids below the bound given at construction, with the DaryHeap interface. Nodes live in one
+// array indexed by id and link by id, so nothing is allocated per push. push() and decrease() are a single meld;
+// pop() pairs the root's children left to right and melds the pairs right to left, O(log n) amortised. Pays off over
+// DaryHeap when decreases far outnumber pops, as on dense graphs.
+template<typename Key>
+class PairingHeap {
+public:
+    using Id = std::uint32_t;
+
+    explicit PairingHeap(std::size_t idBound) : nodes(idBound) {}
+
+    [[nodiscard]] bool empty() const { return root == none; }
+    [[nodiscard]] std::size_t size() const { return count; }
+
+    void push(Id id, Key key);
+    void decrease(Id id, Key key);
+    std::pair<Id, Key> pop();
+    // Nodes are reinitialised by push(), so dropping the root forgets the whole tree
+    void clear() {
+        root = none;
+        count = 0;
+    }
+
+private:
+    static constexpr Id none = std::numeric_limits<Id>::max();
+    // prev is the parent for a leftmost child and the left sibling otherwise
+    struct Node {
+        Key key{};
+        Id child = none;
+        Id sibling = none;
+        Id prev = none;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Id> pending;  // Children of the popped root, kept to reuse its capacity
+    Id root = none;
+    std::size_t count = 0;
+
+    // Links two detached trees and returns the root of the result
+    Id meld(Id first, Id second);
+};
+
+template<typename Key>
+void PairingHeap<Key>::push(Id id, Key key) {
+    nodes[id] = Node{key, none, none, none};
+    root = meld(root, id);
+    ++count;
+}
+
+template<typename Key>
+void PairingHeap<Key>::decrease(Id id, Key key) {
+    Node& node = nodes[id];
+    node.key = key;
+    if (id == root) {
+        return;
+    }
+    // Cut the subtree out of its sibling list and meld it back at the top
+    Node& prev = nodes[node.prev];
+    if (prev.child == id) {
+        prev.child = node.sibling;
+    } else {
+        prev.sibling = node.sibling;
+    }
+    if (node.sibling != none) {
+        nodes[node.sibling].prev = node.prev;
+    }
+    node.sibling = none;
+    node.prev = none;
+    root = meld(root, id);
+}
+
+template<typename Key>
+std::pair<typename PairingHeap<Key>::Id, Key> PairingHeap<Key>::pop() {
+    const Id top = root;
+    pending.clear();
+    for (Id child = nodes[top].child; child != none;) {
+        Id next = nodes[child].sibling;
+        nodes[child].sibling = none;
+        nodes[child].prev = none;
+        pending.push_back(child);
+        child = next;
+    }
+    std::size_t pairs = 0;
+    for (std::size_t i = 0; i + 1 < pending.size(); i += 2) {
+        pending[pairs++] = meld(pending[i], pending[i + 1]);
+    }
+    if (pending.size() % 2 == 1) {
+        pending[pairs++] = pending.back();
+    }
+    root = none;
+    while (pairs > 0) {
+        root = meld(pending[--pairs], root);
+    }
+    --count;
+    return {top, nodes[top].key};
+}
+
+template<typename Key>
+typename PairingHeap<Key>::Id PairingHeap<Key>::meld(Id first, Id second) {
+    if (first == none) {
+        return second;
+    }
+    if (second == none) {
+        return first;
+    }
+    if (nodes[second].key < nodes[first].key) {
+        std::swap(first, second);
+    }
+    Node& parent = nodes[first];
+    Node& child = nodes[second];
+    child.sibling = parent.child;
+    child.prev = first;
+    if (parent.child != none) {
+        nodes[parent.child].prev = second;
+    }
+    parent.child = second;
+    return first;
+}
+#endif
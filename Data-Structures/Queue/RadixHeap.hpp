@@ -0,0 +1,102 @@
+// Created by Aaron H on 5/28/24.
+#ifndef RADIXHEAP_HPP
+#define RADIXHEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Monotone radix heap (Ahuja, Mehlhorn, Orlin and Tarjan) for non-negative integral keys, with the DaryHeap interface.
+// Keys pushed must not be below the last key popped, which Dijkstra's algorithm guarantees. Bucket b > 0 holds keys
+// whose highest bit differing from the last popped key is bit b - 1, so an entry only ever moves to lower buckets and
+// is touched at most once per key bit. decrease() pushes a second entry rather than finding the first, which means
+// pop() can return an id again with an outdated, larger key; callers skip those.
+template<typename Key>
+class RadixHeap {
+    static_assert(std::is_integral<Key>::value, "Radix heap keys must be integral");
+    using Bits = std::make_unsigned_t<Key>;
+    static constexpr std::size_t bucketCount = std::numeric_limits<Bits>::digits + 1;
+public:
+    using Id = std::uint32_t;
+
+    explicit RadixHeap(std::size_t) {}
+
+    [[nodiscard]] bool empty() const { return count == 0; }
+    // Counts outdated entries too
+    [[nodiscard]] std::size_t size() const { return count; }
+
+    void push(Id id, Key key) {
+        buckets[bucketOf(key)].push_back(Entry{key, id});
+        ++count;
+    }
+    void decrease(Id id, Key key) { push(id, key); }
+    std::pair<Id, Key> pop();
+    void clear();
+
+private:
+    struct Entry {
+        Key key;
+        Id id;
+    };
+
+    std::vector<Entry> buckets[bucketCount];
+    Key last = 0;
+    std::size_t count = 0;
+
+    std::size_t bucketOf(Key key) const;
+};
+
+template<typename Key>
+std::size_t RadixHeap<Key>::bucketOf(Key key) const {
+    auto differing = static_cast<unsigned long long>(static_cast<Bits>(key) ^ static_cast<Bits>(last));
+#if defined(__GNUC__)
+    return differing == 0 ? 0 : std::numeric_limits<unsigned long long>::digits - __builtin_clzll(differing);
+#else
+    std::size_t width = 0;
+    for (; differing != 0; differing >>= 1) {
+        ++width;
+    }
+    return width;
+#endif
+}
+
+// With bucket 0 empty, the smallest key sits in the first non-empty bucket. It becomes the new last key and that
+// bucket is redistributed: its entries now share more leading bits with last, so they all land in lower buckets.
+template<typename Key>
+std::pair<typename RadixHeap<Key>::Id, Key> RadixHeap<Key>::pop() {
+    if (buckets[0].empty()) {
+        std::size_t bucket = 1;
+        while (buckets[bucket].empty()) {
+            ++bucket;
+        }
+        auto& spill = buckets[bucket];
+        Key smallest = spill.front().key;
+        for (const Entry& entry : spill) {
+            if (entry.key < smallest) {
+                smallest = entry.key;
+            }
+        }
+        last = smallest;
+        for (const Entry& entry : spill) {
+            buckets[bucketOf(entry.key)].push_back(entry);
+        }
+        spill.clear();
+    }
+    Entry top = buckets[0].back();
+    buckets[0].pop_back();
+    --count;
+    return {top.id, top.key};
+}
+
+template<typename Key>
+void RadixHeap<Key>::clear() {
+    for (auto& bucket : buckets) {
+        bucket.clear();
+    }
+    last = 0;
+    count = 0;
+}
+#endif
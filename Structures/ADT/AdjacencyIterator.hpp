@@ -0,0 +1,69 @@
+// Created by Aaron H on 5/28/24.
+#ifndef ADJACENCYITERATOR_HPP
+#define ADJACENCYITERATOR_HPP
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// Walks a vertex's stored (id, weight) edges but presents them as (vertex, weight) pairs, translating ids back
+// through the interner only when an element is actually dereferenced.
+template<typename Interner, typename BaseIterator, typename EdgeType>
+class AdjacencyIterator {
+public:
+    using VerticeType = std::decay_t<decltype(std::declval<const Interner&>().value(0))>;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<VerticeType, EdgeType>;
+    using reference = std::pair<const VerticeType&, EdgeType&>;
+    using difference_type = std::ptrdiff_t;
+
+    struct pointer {
+        reference ref;
+        reference* operator->() { return &ref; }
+    };
+
+    AdjacencyIterator() = default;
+    AdjacencyIterator(BaseIterator base, const Interner* interner) : base(base), interner(interner) {}
+
+    reference operator*() const { return reference(interner->value(base->first), base->second); }
+    pointer operator->() const { return pointer{**this}; }
+
+    AdjacencyIterator& operator++() { ++base; return *this; }
+    AdjacencyIterator operator++(int) { AdjacencyIterator copy = *this; ++base; return copy; }
+
+    bool operator==(const AdjacencyIterator& other) const { return base == other.base; }
+    bool operator!=(const AdjacencyIterator& other) const { return base != other.base; }
+
+private:
+    BaseIterator base{};
+    const Interner* interner = nullptr;
+};
+
+// Walks a list of vertex ids and yields the vertices they stand for
+template<typename Interner, typename BaseIterator>
+class VertexIdIterator {
+public:
+    using VerticeType = std::decay_t<decltype(std::declval<const Interner&>().value(0))>;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = VerticeType;
+    using reference = const VerticeType&;
+    using pointer = const VerticeType*;
+    using difference_type = std::ptrdiff_t;
+
+    VertexIdIterator() = default;
+    VertexIdIterator(BaseIterator base, const Interner* interner) : base(base), interner(interner) {}
+
+    reference operator*() const { return interner->value(*base); }
+    pointer operator->() const { return &interner->value(*base); }
+
+    VertexIdIterator& operator++() { ++base; return *this; }
+    VertexIdIterator operator++(int) { VertexIdIterator copy = *this; ++base; return copy; }
+
+    bool operator==(const VertexIdIterator& other) const { return base == other.base; }
+    bool operator!=(const VertexIdIterator& other) const { return base != other.base; }
+
+private:
+    BaseIterator base{};
+    const Interner* interner = nullptr;
+};
+#endif
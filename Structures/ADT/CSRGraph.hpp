@@ -0,0 +1,68 @@
+// Created by Aaron H on 5/28/24.
+#ifndef CSRGRAPH_HPP
+#define CSRGRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "GraphStats.hpp"
+#include "../../Data-Structures/Hash-Tables/FlatHashMap.hpp"
+
+// Immutable compressed-sparse-row snapshot of a graph. Vertices get dense ids 0..n-1, the out-edges of id u are
+// targets[offsets[u] .. offsets[u + 1]) with matching weights, so traversals walk contiguous memory.
+// Optionally the transpose is kept as well (sources of in-edges, unweighted) for pull-style and bottom-up traversals.
+template<typename VerticeType, typename EdgeType>
+class CSRGraph {
+public:
+    using VertexId = std::uint32_t;
+    using Weight = EdgeType;
+
+    CSRGraph() = default;
+    CSRGraph(std::vector<VerticeType> vertices, std::vector<std::size_t> offsets,
+             std::vector<VertexId> targets, std::vector<EdgeType> weights, bool withInEdges = false);
+
+    [[nodiscard]] unsigned int numVertices() const;
+    [[nodiscard]] unsigned int numEdges() const;
+
+    bool hasVertex(const VerticeType &vertex) const;
+    bool hasEdge(const VerticeType &v1, const VerticeType &v2) const;
+
+    VertexId idOf(const VerticeType &vertex) const;
+    const VerticeType& vertexOf(VertexId id) const { return vertices[id]; }
+
+    [[nodiscard]] VertexId idBound() const { return static_cast<VertexId>(vertices.size()); }
+    [[nodiscard]] bool containsId(VertexId id) const { return id < vertices.size(); }
+    [[nodiscard]] std::size_t outDegree(VertexId id) const { return offsets[id + 1] - offsets[id]; }
+    [[nodiscard]] VertexId neighborAt(VertexId id, std::size_t index) const { return targets[offsets[id] + index]; }
+    const VertexId* neighborsBegin(VertexId id) const { return targets.data() + offsets[id]; }
+    const VertexId* neighborsEnd(VertexId id) const { return targets.data() + offsets[id + 1]; }
+    const EdgeType* weightsBegin(VertexId id) const { return weights.data() + offsets[id]; }
+    // Computed once at construction
+    [[nodiscard]] bool hasNegativeWeights() const { return negativeWeights; }
+
+    [[nodiscard]] bool hasInEdges() const { return !inOffsets.empty(); }
+    [[nodiscard]] std::size_t inDegree(VertexId id) const { return inOffsets[id + 1] - inOffsets[id]; }
+    const VertexId* inNeighborsBegin(VertexId id) const { return inSources.data() + inOffsets[id]; }
+    const VertexId* inNeighborsEnd(VertexId id) const { return inSources.data() + inOffsets[id + 1]; }
+
+    const std::vector<std::size_t>& rowOffsets() const { return offsets; }
+    const std::vector<VertexId>& columnTargets() const { return targets; }
+    const std::vector<EdgeType>& edgeWeights() const { return weights; }
+    const std::vector<std::size_t>& inRowOffsets() const { return inOffsets; }
+    const std::vector<VertexId>& inColumnSources() const { return inSources; }
+
+private:
+    std::vector<VerticeType> vertices;
+    FlatHashMap<VerticeType, VertexId> ids;
+    std::vector<std::size_t> offsets;
+    std::vector<VertexId> targets;
+    std::vector<EdgeType> weights;
+    std::vector<std::size_t> inOffsets;
+    std::vector<VertexId> inSources;
+    bool negativeWeights = false;
+
+    void buildInEdges();
+};
+#include "CSRGraph.tpp"
+#endif
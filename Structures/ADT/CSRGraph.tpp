@@ -0,0 +1,79 @@
+#include "CSRGraph.hpp"
+#include <algorithm>
+
+template<typename VerticeType, typename EdgeType>
+CSRGraph<VerticeType, EdgeType>::CSRGraph(std::vector<VerticeType> vertices, std::vector<std::size_t> offsets,
+                                          std::vector<VertexId> targets, std::vector<EdgeType> weights, bool withInEdges)
+        : vertices(std::move(vertices)), offsets(std::move(offsets)), targets(std::move(targets)), weights(std::move(weights)) {
+    if (this->offsets.size() != this->vertices.size() + 1 || this->targets.size() != this->weights.size()
+        || this->offsets.back() != this->targets.size()) {
+        throw std::runtime_error("Malformed compressed sparse row arrays");
+    }
+    ids.reserve(this->vertices.size());
+    for (VertexId id = 0; id < this->vertices.size(); ++id) {
+        ids.emplace(this->vertices[id], id);
+    }
+    negativeWeights = std::any_of(this->weights.begin(), this->weights.end(),
+                                  [](const EdgeType& weight) { return isNegativeWeight(weight); });
+    if (withInEdges) {
+        buildInEdges();
+    }
+}
+
+// Counting sort of the edges by target; sources come out in ascending order within every row
+template<typename VerticeType, typename EdgeType>
+void CSRGraph<VerticeType, EdgeType>::buildInEdges() {
+    inOffsets.assign(vertices.size() + 1, 0);
+    for (VertexId target : targets) {
+        ++inOffsets[target + 1];
+    }
+    for (std::size_t id = 0; id < vertices.size(); ++id) {
+        inOffsets[id + 1] += inOffsets[id];
+    }
+    inSources.resize(targets.size());
+    std::vector<std::size_t> cursor(inOffsets.begin(), inOffsets.end() - 1);
+    for (VertexId source = 0; source < vertices.size(); ++source) {
+        for (std::size_t edge = offsets[source]; edge < offsets[source + 1]; ++edge) {
+            inSources[cursor[targets[edge]]++] = source;
+        }
+    }
+}
+
+template<typename VerticeType, typename EdgeType>
+unsigned int CSRGraph<VerticeType, EdgeType>::numVertices() const {
+    return vertices.size();
+}
+
+template<typename VerticeType, typename EdgeType>
+unsigned int CSRGraph<VerticeType, EdgeType>::numEdges() const {
+    return targets.size();
+}
+
+template<typename VerticeType, typename EdgeType>
+bool CSRGraph<VerticeType, EdgeType>::hasVertex(const VerticeType &vertex) const {
+    return ids.find(vertex) != ids.end();
+}
+
+template<typename VerticeType, typename EdgeType>
+bool CSRGraph<VerticeType, EdgeType>::hasEdge(const VerticeType &v1, const VerticeType &v2) const {
+    auto it1 = ids.find(v1);
+    auto it2 = ids.find(v2);
+    if (it1 == ids.end() || it2 == ids.end()) {
+        return false;
+    }
+    for (auto iter = neighborsBegin(it1->second); iter != neighborsEnd(it1->second); ++iter) {
+        if (*iter == it2->second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename VerticeType, typename EdgeType>
+typename CSRGraph<VerticeType, EdgeType>::VertexId CSRGraph<VerticeType, EdgeType>::idOf(const VerticeType &vertex) const {
+    auto it = ids.find(vertex);
+    if (it == ids.end()) {
+        throw std::runtime_error("Vertex does not exist in the graph");
+    }
+    return it->second;
+}
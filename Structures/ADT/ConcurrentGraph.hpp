@@ -0,0 +1,98 @@
+// Created by Aaron H on 5/28/24.
+#ifndef CONCURRENTGRAPH_HPP
+#define CONCURRENTGRAPH_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Graph.hpp"
+
+// A graph shared between one writer thread and many reader threads. The writer mutates a private DerivedGraph and
+// publish() freezes it into an immutable CSRGraph snapshot that replaces the current one with a single pointer swap.
+// Readers pin the current snapshot and query it without locks or shared writes; snapshots pinned by a reader stay
+// valid until it unpins, and retired snapshots are freed by epoch-based reclamation once no reader can still hold
+// them. publish() costs a full freeze, O(V + E), so writers should batch mutations between publishes.
+template<typename VerticeType, typename EdgeType>
+class ConcurrentGraph {
+public:
+    using Snapshot = CSRGraph<VerticeType, EdgeType>;
+
+    // Pins a snapshot for its lifetime. Holds the reader's slot, so a Reader pins one snapshot at a time.
+    class SnapshotGuard {
+    public:
+        SnapshotGuard(const SnapshotGuard&) = delete;
+        SnapshotGuard& operator=(const SnapshotGuard&) = delete;
+        SnapshotGuard(SnapshotGuard&& other) noexcept : slot(other.slot), pinned(other.pinned) { other.slot = nullptr; }
+        ~SnapshotGuard();
+
+        const Snapshot& graph() const { return *pinned; }
+        const Snapshot* operator->() const { return pinned; }
+        const Snapshot& operator*() const { return *pinned; }
+
+    private:
+        friend class ConcurrentGraph;
+        SnapshotGuard(std::atomic<std::uint64_t>* slot, const Snapshot* pinned) : slot(slot), pinned(pinned) {}
+        std::atomic<std::uint64_t>* slot;
+        const Snapshot* pinned;
+    };
+
+    // One per reader thread; claims one of the slots reserved at construction and releases it on destruction
+    class Reader {
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader(Reader&& other) noexcept : owner(other.owner), slot(other.slot) { other.owner = nullptr; }
+        ~Reader();
+
+        SnapshotGuard pin() const;
+
+    private:
+        friend class ConcurrentGraph;
+        Reader(const ConcurrentGraph* owner, std::size_t slot);
+        const ConcurrentGraph* owner;
+        std::size_t slot;
+    };
+
+    explicit ConcurrentGraph(GraphType type, std::size_t maxReaders = 64, bool withInEdges = false);
+    ConcurrentGraph(const ConcurrentGraph&) = delete;
+    ConcurrentGraph& operator=(const ConcurrentGraph&) = delete;
+    // Every Reader must be gone by now
+    ~ConcurrentGraph();
+
+    // Throws if all maxReaders slots are taken
+    Reader reader() const;
+
+    // Writer side, for the writer thread only: mutate staging(), then publish() the batch
+    DerivedGraph<VerticeType, EdgeType>& staging() { return writerGraph; }
+    void publish();
+    [[nodiscard]] std::uint64_t version() const { return publishedVersion.load(std::memory_order_acquire); }
+    // Retired snapshots still waiting for readers to move on
+    [[nodiscard]] std::size_t pendingReclamation() const { return retired.size(); }
+
+private:
+    // Readers announce the epoch they pinned at, 0 while idle. One cache line each so pins never contend.
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> pinnedEpoch{0};
+        std::atomic<bool> claimed{false};
+    };
+    struct Retired {
+        const Snapshot* snapshot;
+        std::uint64_t epoch;
+    };
+
+    DerivedGraph<VerticeType, EdgeType> writerGraph;
+    bool withInEdges;
+    std::atomic<const Snapshot*> current{nullptr};
+    std::atomic<std::uint64_t> epoch{1};
+    std::atomic<std::uint64_t> publishedVersion{0};
+    std::unique_ptr<Slot[]> slots;
+    std::size_t slotCount;
+    std::vector<Retired> retired;
+
+    void reclaim();
+};
+
+#include "ConcurrentGraph.tpp"
+#endif
@@ -0,0 +1,84 @@
+#include "ConcurrentGraph.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+template<typename VerticeType, typename EdgeType>
+ConcurrentGraph<VerticeType, EdgeType>::ConcurrentGraph(GraphType type, std::size_t maxReaders, bool withInEdges)
+        : writerGraph(type), withInEdges(withInEdges), slots(new Slot[maxReaders]), slotCount(maxReaders) {
+    current.store(new Snapshot(writerGraph.freeze(withInEdges)), std::memory_order_release);
+}
+
+template<typename VerticeType, typename EdgeType>
+ConcurrentGraph<VerticeType, EdgeType>::~ConcurrentGraph() {
+    for (const Retired& entry : retired) {
+        delete entry.snapshot;
+    }
+    delete current.load(std::memory_order_acquire);
+}
+
+template<typename VerticeType, typename EdgeType>
+typename ConcurrentGraph<VerticeType, EdgeType>::Reader ConcurrentGraph<VerticeType, EdgeType>::reader() const {
+    for (std::size_t slot = 0; slot < slotCount; ++slot) {
+        bool expected = false;
+        if (slots[slot].claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return Reader(this, slot);
+        }
+    }
+    throw std::runtime_error("All reader slots of the concurrent graph are taken");
+}
+
+// The old snapshot is retired at the epoch after the swap. A reader that could still hold it announced an older
+// epoch before loading the pointer, and every announcement is seq_cst, so the writer's scan sees it and waits.
+template<typename VerticeType, typename EdgeType>
+void ConcurrentGraph<VerticeType, EdgeType>::publish() {
+    const Snapshot* next = new Snapshot(writerGraph.freeze(withInEdges));
+    const Snapshot* previous = current.exchange(next, std::memory_order_seq_cst);
+    const std::uint64_t retiredAt = epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    retired.push_back(Retired{previous, retiredAt});
+    publishedVersion.fetch_add(1, std::memory_order_release);
+    reclaim();
+}
+
+template<typename VerticeType, typename EdgeType>
+void ConcurrentGraph<VerticeType, EdgeType>::reclaim() {
+    std::uint64_t oldestPinned = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t slot = 0; slot < slotCount; ++slot) {
+        const std::uint64_t pinned = slots[slot].pinnedEpoch.load(std::memory_order_seq_cst);
+        if (pinned != 0) {
+            oldestPinned = std::min(oldestPinned, pinned);
+        }
+    }
+    auto stillVisible = std::remove_if(retired.begin(), retired.end(), [oldestPinned](const Retired& entry) {
+        if (entry.epoch > oldestPinned) {
+            return false;
+        }
+        delete entry.snapshot;
+        return true;
+    });
+    retired.erase(stillVisible, retired.end());
+}
+
+template<typename VerticeType, typename EdgeType>
+ConcurrentGraph<VerticeType, EdgeType>::Reader::Reader(const ConcurrentGraph* owner, std::size_t slot) : owner(owner), slot(slot) {}
+
+template<typename VerticeType, typename EdgeType>
+ConcurrentGraph<VerticeType, EdgeType>::Reader::~Reader() {
+    if (owner != nullptr) {
+        owner->slots[slot].claimed.store(false, std::memory_order_release);
+    }
+}
+
+template<typename VerticeType, typename EdgeType>
+typename ConcurrentGraph<VerticeType, EdgeType>::SnapshotGuard ConcurrentGraph<VerticeType, EdgeType>::Reader::pin() const {
+    std::atomic<std::uint64_t>& announced = owner->slots[slot].pinnedEpoch;
+    announced.store(owner->epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    return SnapshotGuard(&announced, owner->current.load(std::memory_order_seq_cst));
+}
+
+template<typename VerticeType, typename EdgeType>
+ConcurrentGraph<VerticeType, EdgeType>::SnapshotGuard::~SnapshotGuard() {
+    if (slot != nullptr) {
+        slot->store(0, std::memory_order_release);
+    }
+}
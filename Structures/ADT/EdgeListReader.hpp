@@ -0,0 +1,38 @@
+// Created by Aaron H on 5/28/24.
+#ifndef EDGELISTREADER_HPP
+#define EDGELISTREADER_HPP
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Graph.hpp"
+#include "../../Algorithms/Parallel/ParallelFor.hpp"
+
+struct EdgeListOptions {
+    unsigned threads = Parallel::defaultThreadCount();
+    // Bytes per parsing task; lines straddling a boundary belong to the task they start in
+    std::size_t chunkBytes = std::size_t{8} << 20;
+    char comment = '#';
+};
+
+// Parses a SNAP-style text edge list: one "source destination [weight]" per line, fields separated by spaces, tabs
+// or commas, blank lines and lines starting with the comment character skipped, LF or CRLF endings. Lines without a
+// weight get EdgeType(1). Numbers are read in place with std::from_chars, so VerticeType and EdgeType must be
+// arithmetic. Chunks are parsed in parallel and concatenated in file order; a malformed line throws with its offset.
+template<typename VerticeType, typename EdgeType>
+std::vector<std::tuple<VerticeType, VerticeType, EdgeType>> parseEdgeList(const char* begin, const char* end,
+                                                                          const EdgeListOptions& options = EdgeListOptions());
+
+// Maps the file and parses it as above
+template<typename VerticeType, typename EdgeType>
+std::vector<std::tuple<VerticeType, VerticeType, EdgeType>> readEdgeList(const std::string& path,
+                                                                         const EdgeListOptions& options = EdgeListOptions());
+
+// readEdgeList() fed straight into DerivedGraph::from_edges
+template<typename VerticeType, typename EdgeType>
+DerivedGraph<VerticeType, EdgeType> loadEdgeList(const std::string& path, GraphType type,
+                                                 const EdgeListOptions& options = EdgeListOptions());
+
+#include "EdgeListReader.tpp"
+#endif
@@ -0,0 +1,176 @@
+#include "EdgeListReader.hpp"
+#include "MappedFile.hpp"
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace EdgeListDetail {
+
+    inline bool isSeparator(char c) {
+        return c == ' ' || c == '\t' || c == ',';
+    }
+
+    inline const char* skipSeparators(const char* cursor, const char* end) {
+        while (cursor != end && isSeparator(*cursor)) {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    // Characters a decimal floating-point token may hold; hex floats ("0x...") are left out, as from_chars does
+    inline bool isFloatCharacter(char c) {
+        return (std::isalnum(static_cast<unsigned char>(c)) && c != 'x' && c != 'X') || c == '.' || c == '+' || c == '-';
+    }
+
+    // std::from_chars for integers. Floating-point from_chars is missing from some standard libraries (e.g. the
+    // libc++ of AppleClang 15), so floating-point values are copied to a bounded stack buffer and read with strtod.
+    // Like from_chars it rejects a leading '+' and whitespace; unlike it, it follows the C locale's decimal point,
+    // which is '.' unless the program calls setlocale.
+    template<typename Number>
+    std::from_chars_result parseNumber(const char* first, const char* last, Number& value) {
+        if constexpr (std::is_floating_point_v<Number>) {
+            constexpr std::size_t maxLength = 127;
+            char buffer[maxLength + 1];
+            std::size_t length = 0;
+            while (first + length != last && length < maxLength && isFloatCharacter(first[length])) {
+                buffer[length] = first[length];
+                ++length;
+            }
+            buffer[length] = '\0';
+            if (length == 0 || buffer[0] == '+') {
+                return {first, std::errc::invalid_argument};
+            }
+            char* parsedEnd = nullptr;
+            errno = 0;
+            Number parsed;
+            if constexpr (std::is_same_v<Number, float>) {
+                parsed = std::strtof(buffer, &parsedEnd);
+            } else if constexpr (std::is_same_v<Number, double>) {
+                parsed = std::strtod(buffer, &parsedEnd);
+            } else {
+                parsed = std::strtold(buffer, &parsedEnd);
+            }
+            if (parsedEnd == buffer) {
+                return {first, std::errc::invalid_argument};
+            }
+            if (errno == ERANGE) {
+                return {first + (parsedEnd - buffer), std::errc::result_out_of_range};
+            }
+            value = parsed;
+            return {first + (parsedEnd - buffer), std::errc()};
+        } else {
+            return std::from_chars(first, last, value);
+        }
+    }
+
+    // Parses the lines that start in [chunkBegin, chunkEnd), finishing the last one past chunkEnd if needed.
+    // Returns the offset of the first malformed line, or npos.
+    template<typename VerticeType, typename EdgeType>
+    std::size_t parseChunk(const char* begin, const char* end, std::size_t chunkBegin, std::size_t chunkEnd, char comment,
+                           std::vector<std::tuple<VerticeType, VerticeType, EdgeType>>& edges) {
+        constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+        const char* cursor = begin + chunkBegin;
+        if (chunkBegin > 0 && cursor[-1] != '\n') {
+            const void* newline = std::memchr(cursor, '\n', end - cursor);
+            cursor = newline == nullptr ? end : static_cast<const char*>(newline) + 1;
+        }
+        const char* stop = begin + chunkEnd;
+        while (cursor < stop) {
+            const char* lineStart = cursor;
+            const void* newline = std::memchr(cursor, '\n', end - cursor);
+            const char* lineEnd = newline == nullptr ? end : static_cast<const char*>(newline);
+            const char* next = newline == nullptr ? end : lineEnd + 1;
+            if (lineEnd != lineStart && lineEnd[-1] == '\r') {
+                --lineEnd;
+            }
+            cursor = skipSeparators(cursor, lineEnd);
+            if (cursor == lineEnd || *cursor == comment) {
+                cursor = next;
+                continue;
+            }
+            VerticeType source{};
+            VerticeType destination{};
+            EdgeType weight = EdgeType(1);
+            auto parsed = parseNumber(cursor, lineEnd, source);
+            if (parsed.ec != std::errc() || parsed.ptr == lineEnd || !isSeparator(*parsed.ptr)) {
+                return static_cast<std::size_t>(lineStart - begin);
+            }
+            parsed = parseNumber(skipSeparators(parsed.ptr, lineEnd), lineEnd, destination);
+            if (parsed.ec != std::errc()) {
+                return static_cast<std::size_t>(lineStart - begin);
+            }
+            // An optional weight, then only separators or a trailing comment
+            cursor = skipSeparators(parsed.ptr, lineEnd);
+            if (cursor != lineEnd && *cursor != comment) {
+                if (cursor == parsed.ptr) {
+                    return static_cast<std::size_t>(lineStart - begin);
+                }
+                parsed = parseNumber(cursor, lineEnd, weight);
+                cursor = skipSeparators(parsed.ptr, lineEnd);
+                if (parsed.ec != std::errc() || (cursor != lineEnd && *cursor != comment)) {
+                    return static_cast<std::size_t>(lineStart - begin);
+                }
+            }
+            edges.emplace_back(source, destination, weight);
+            cursor = next;
+        }
+        return npos;
+    }
+
+}  // namespace EdgeListDetail
+
+template<typename VerticeType, typename EdgeType>
+std::vector<std::tuple<VerticeType, VerticeType, EdgeType>> parseEdgeList(const char* begin, const char* end,
+                                                                          const EdgeListOptions& options) {
+    static_assert(std::is_arithmetic<VerticeType>::value && std::is_arithmetic<EdgeType>::value,
+                  "Edge lists hold numeric vertices and weights");
+    using Edge = std::tuple<VerticeType, VerticeType, EdgeType>;
+    constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+    const std::size_t size = static_cast<std::size_t>(end - begin);
+    const std::size_t grain = std::max<std::size_t>(options.chunkBytes, 1);
+    const std::size_t chunks = (size + grain - 1) / grain;
+
+    // Chunks report errors by offset rather than throwing, so the error names the first malformed line in the file
+    std::vector<std::vector<Edge>> parts(chunks);
+    std::vector<std::size_t> malformed(chunks, npos);
+    Parallel::parallelFor(0, size, grain, options.threads, [&](unsigned, std::size_t chunkBegin, std::size_t chunkEnd) {
+        const std::size_t chunk = chunkBegin / grain;
+        parts[chunk].reserve((chunkEnd - chunkBegin) / 16);
+        malformed[chunk] = EdgeListDetail::parseChunk(begin, end, chunkBegin, chunkEnd, options.comment, parts[chunk]);
+    });
+    for (std::size_t offset : malformed) {
+        if (offset != npos) {
+            throw std::runtime_error("Malformed edge list line at byte " + std::to_string(offset));
+        }
+    }
+
+    if (parts.size() == 1) {
+        return std::move(parts.front());
+    }
+    std::size_t total = 0;
+    for (const auto& part : parts) {
+        total += part.size();
+    }
+    std::vector<Edge> edges;
+    edges.reserve(total);
+    for (auto& part : parts) {
+        edges.insert(edges.end(), part.begin(), part.end());
+        std::vector<Edge>().swap(part);
+    }
+    return edges;
+}
+
+template<typename VerticeType, typename EdgeType>
+std::vector<std::tuple<VerticeType, VerticeType, EdgeType>> readEdgeList(const std::string& path, const EdgeListOptions& options) {
+    MappedFile file(path, MappedFile::Sequential);
+    return parseEdgeList<VerticeType, EdgeType>(file.data(), file.data() + file.size(), options);
+}
+
+template<typename VerticeType, typename EdgeType>
+DerivedGraph<VerticeType, EdgeType> loadEdgeList(const std::string& path, GraphType type, const EdgeListOptions& options) {
+    return DerivedGraph<VerticeType, EdgeType>::from_edges(readEdgeList<VerticeType, EdgeType>(path, options), type);
+}
@@ -1,14 +1,46 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <algorithm>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include "AdjacencyIterator.hpp"
+#include "CSRGraph.hpp"
+#include "GraphMetrics.hpp"
+#include "GraphStats.hpp"
+#include "VertexInterner.hpp"
+#include "../../Data-Structures/Array/DenseBitset.hpp"
 
 enum GraphType {
     DAG,
     UDG
 };
 
+// Graph type as a DerivedGraph policy. RuntimeGraphType keeps the type passed at construction; StaticGraphType fixes
+// it in the type, so the DAG branch in addEdge is a constant and an unchecked construction loop inlines down to the
+// appends. Constructing a static policy with the other type throws.
+struct RuntimeGraphType {
+    RuntimeGraphType() = default;
+    RuntimeGraphType(GraphType type) : value(type) {}
+    [[nodiscard]] GraphType type() const { return value; }
+    GraphType value = DAG;
+};
+
+template<GraphType Type>
+struct StaticGraphType {
+    StaticGraphType() = default;
+    StaticGraphType(GraphType type) {
+        if (type != Type) {
+            throw std::runtime_error("Graph type does not match the graph's type policy");
+        }
+    }
+    static constexpr GraphType type() { return Type; }
+};
+
 template<typename VerticeType, typename EdgeType>
 class Graph {
 public:
@@ -22,18 +54,114 @@ public:
     [[maybe_unused]] [[nodiscard]] virtual unsigned int numEdges() const = 0;
 };
 
-template<typename VerticeType, typename EdgeType>
-class DerivedGraph: public Graph<VerticeType, EdgeType> {
+// Final, so calls through a DerivedGraph or a reference to one bind statically and inline; the virtual Graph base is
+// only paid for by callers that hold a Graph&.
+template<typename VerticeType, typename EdgeType, typename TypePolicy = RuntimeGraphType>
+class DerivedGraph final : public Graph<VerticeType, EdgeType> {
+public:
+    using VertexId = typename VertexInterner<VerticeType>::VertexId;
+    using IdEdge = std::pair<VertexId, EdgeType>;
+    using Weight = EdgeType;
 private:
-    std::unordered_map<VerticeType, std::vector<std::pair<VerticeType, EdgeType>>> adjacencyList;
-    GraphType graphType;
+    // Vertices are interned once; adjacency is indexed by id and stores ids only. The interner and the per-vertex
+    // lists draw from one memory resource, so an arena-backed graph makes a handful of large allocations.
+    VertexInterner<VerticeType> vertices;
+    std::pmr::vector<std::pmr::vector<IdEdge>> adjacencyList;
+    // Hub vertices additionally keep their neighbors in a hash set so membership tests stop scanning the list. A set
+    // is built once a vertex's out-degree reaches hubThreshold and dropped when it falls below half of that.
+    PmrFlatHashMap<VertexId, PmrFlatHashSet<VertexId>> hubNeighbors;
+    TypePolicy graphType;
+
+    // Optional reverse index: the sources of every vertex's in-edges, so vertex removal only touches its neighbors
+    bool inEdgesIndexed = true;
+    std::pmr::vector<std::pmr::vector<VertexId>> predecessorList;
+
+    DegreeCounters counters;
+
+    // Topological order kept alive across DAG inserts so a cycle check only searches the affected region.
+    // Slots of removed vertices hold npos until enough of them pile up to compact.
+    std::vector<VertexId> topologicalOrder;
+    std::vector<std::size_t> topologicalIndex;
+    std::size_t deadTopologicalSlots = 0;
+    bool topologicalOrderValid = true;
+    DenseBitset searchMark;  // All clear between searches
+    // Scratch kept so checked inserts do not allocate once the buffers have grown
+    std::vector<VertexId> searchQueue;
+    std::vector<std::size_t> reorderSlots;
+    std::vector<VertexId> reorderShifted;
+    std::vector<VertexId> reorderKept;
+
+    VertexId requireId(const VerticeType &vertex) const;
+    VertexId insertVertex(const VerticeType &vertex);
+    bool linked(VertexId source, VertexId destination) const;
+    void indexHub(VertexId id);
+    void requireInEdgeIndex() const;
+    bool eraseEdgeTo(VertexId source, VertexId destination);
+    static void erasePredecessor(std::pmr::vector<VertexId> &predecessors, VertexId source);
+    bool reorderForEdge(VertexId source, VertexId destination);
+    bool rebuildTopologicalOrder();
+    void compactTopologicalOrder();
 public:
+    static constexpr std::size_t hubThreshold = 64;
+
+    // Collects mutations and applies them all-or-nothing in commit(). A batch is a set of changes, not a script:
+    // edge removals go first, then vertex removals, vertex additions and finally edge additions, so an edge removed
+    // and re-added in one batch is replaced. Everything is validated against the graph as it will be before anything
+    // is touched, and a DAG is checked for cycles once for the whole batch, so a commit that throws leaves the graph
+    // unchanged. Errors carry the same messages as the single-call mutators.
+    class Batch {
+    public:
+        Batch& addVertex(const VerticeType &vertex) { addedVertices.push_back(vertex); return *this; }
+        Batch& removeVertex(const VerticeType &vertex) { removedVertices.push_back(vertex); return *this; }
+        Batch& addEdge(const VerticeType &source, const VerticeType &destination, const EdgeType &weight) {
+            addedEdges.emplace_back(source, destination, weight);
+            return *this;
+        }
+        Batch& addDirectionalEdge(const VerticeType &source, const VerticeType &destination, const EdgeType &weight, bool isDirected) {
+            addEdge(source, destination, weight);
+            return isDirected ? *this : addEdge(destination, source, weight);
+        }
+        // Like DerivedGraph::removeEdge, also drops the reverse edge if there is one
+        Batch& removeEdge(const VerticeType &vertex1, const VerticeType &vertex2) { removedEdges.emplace_back(vertex1, vertex2); return *this; }
+
+        // Empties the batch on success; on failure the batch keeps its changes and the graph is untouched
+        void commit();
+        [[nodiscard]] std::size_t size() const {
+            return addedVertices.size() + removedVertices.size() + addedEdges.size() + removedEdges.size();
+        }
+
+    private:
+        friend class DerivedGraph;
+        static std::uint64_t edgeKey(VertexId source, VertexId destination) {
+            return static_cast<std::uint64_t>(source) << 32 | destination;
+        }
+        explicit Batch(DerivedGraph &graph) : graph(&graph) {}
+
+        DerivedGraph *graph;
+        std::vector<VerticeType> addedVertices;
+        std::vector<VerticeType> removedVertices;
+        std::vector<std::tuple<VerticeType, VerticeType, EdgeType>> addedEdges;
+        std::vector<std::pair<VerticeType, VerticeType>> removedEdges;
+    };
+
+    Batch batch() { return Batch(*this); }
+
+    using AdjacentIterator = AdjacencyIterator<VertexInterner<VerticeType>, typename std::pmr::vector<IdEdge>::iterator, EdgeType>;
+    using PredecessorIterator = VertexIdIterator<VertexInterner<VerticeType>, typename std::pmr::vector<VertexId>::const_iterator>;
+
     DerivedGraph();
-    DerivedGraph(GraphType type) : graphType(type), adjacencyList() {}
+    DerivedGraph(GraphType type) : adjacencyList(), graphType(type) {}
+    DerivedGraph(GraphType type, bool indexInEdges) : adjacencyList(), graphType(type), inEdgesIndexed(indexInEdges) {}
+    // Storage comes from resource, e.g. a std::pmr::monotonic_buffer_resource that outlives the graph. A copy-constructed
+    // graph uses the default resource, move construction keeps the source's and assignment keeps the target's.
+    DerivedGraph(GraphType type, std::pmr::memory_resource* resource, bool indexInEdges = true)
+            : vertices(resource), adjacencyList(resource), hubNeighbors(resource), graphType(type), inEdgesIndexed(indexInEdges),
+              predecessorList(resource) {}
     DerivedGraph(const DerivedGraph& other);
     DerivedGraph(DerivedGraph&& other) noexcept;
     DerivedGraph& operator=(const DerivedGraph& other);
-    DerivedGraph& operator=(DerivedGraph&& other) noexcept;
+    // Not noexcept: with the target keeping its resource, moving between resources copies element by element
+    DerivedGraph& operator=(DerivedGraph&& other);
 
     void addVertex(const VerticeType& vertex) override;
 
@@ -50,14 +178,47 @@ public:
 
     [[nodiscard]] unsigned int numEdges() const override;
 
+    // Edge count, maximum out-degree and a power-of-two out-degree histogram, maintained on every mutation
+    [[nodiscard]] const GraphStats& stats() const { return counters.stats(); }
+
     bool hasEdge(const VerticeType &v1, const VerticeType &v2) const;
 
-    [[maybe_unused]] static DerivedGraph from_edges(const std::vector<std::tuple<VerticeType, VerticeType, EdgeType>>& edges, GraphType type);
+    [[maybe_unused]] static DerivedGraph from_edges(const std::vector<std::tuple<VerticeType, VerticeType, EdgeType>>& edges, GraphType type,
+                                                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    [[nodiscard]] GraphType type() const { return graphType.type(); }
+
+    [[nodiscard]] std::pmr::memory_resource* resource() const { return adjacencyList.get_allocator().resource(); }
 
     std::vector<VerticeType> getVertices() const;
 
-    auto adjacentBegin(const VerticeType& vertex) -> typename decltype(adjacencyList)::mapped_type::iterator;
-    auto adjacentEnd(const VerticeType& vertex) -> typename decltype(adjacencyList)::mapped_type::iterator;
+    CSRGraph<VerticeType, EdgeType> freeze(bool withInEdges = false) const;
+
+    AdjacentIterator adjacentBegin(const VerticeType& vertex);
+    AdjacentIterator adjacentEnd(const VerticeType& vertex);
+
+    // In-edge queries; these throw if the graph was built without the in-edge index
+    [[nodiscard]] bool hasInEdgeIndex() const { return inEdgesIndexed; }
+    std::size_t inDegree(const VerticeType& vertex) const;
+    PredecessorIterator predecessorsBegin(const VerticeType& vertex) const;
+    PredecessorIterator predecessorsEnd(const VerticeType& vertex) const;
+
+    // Id-level access for algorithms. Ids are dense but recycled, so live ones are those below idBound() with containsId().
+    VertexId idOf(const VerticeType &vertex) const { return requireId(vertex); }
+    const VerticeType& vertexOf(VertexId id) const { return vertices.value(id); }
+    [[nodiscard]] VertexId idBound() const { return vertices.bound(); }
+    [[nodiscard]] bool containsId(VertexId id) const { return vertices.contains(id); }
+    [[nodiscard]] std::size_t outDegree(VertexId id) const { return adjacencyList[id].size(); }
+    [[nodiscard]] VertexId neighborAt(VertexId id, std::size_t index) const { return adjacencyList[id][index].first; }
+    const std::pmr::vector<IdEdge>& adjacentIds(VertexId id) const { return adjacencyList[id]; }
+    const std::pmr::vector<VertexId>& predecessorIds(VertexId id) const { requireInEdgeIndex(); return predecessorList[id]; }
 };
+
+template<typename VerticeType, typename EdgeType>
+using DagGraph = DerivedGraph<VerticeType, EdgeType, StaticGraphType<DAG>>;
+
+template<typename VerticeType, typename EdgeType>
+using UdgGraph = DerivedGraph<VerticeType, EdgeType, StaticGraphType<UDG>>;
+
 #include "Graph.tpp"
 #endif
\ No newline at end of file
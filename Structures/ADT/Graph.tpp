@@ -1,187 +1,738 @@
 #include "Graph.hpp"
 #include "../../Algorithms/GraphAlgorithms/IsCyclic.hpp"
+#include "../../Algorithms/Sorting/RadixSort.hpp"
 
 //Begin implementation of ElementaryGraph template methods
 
-template<typename VerticeType, typename EdgeType>
-DerivedGraph<VerticeType, EdgeType>::DerivedGraph() {
-    adjacencyList = std::unordered_map<VerticeType, std::vector<std::pair<VerticeType, EdgeType>>>();
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+DerivedGraph<VerticeType, EdgeType, TypePolicy>::DerivedGraph() {
+    adjacencyList = std::pmr::vector<std::pmr::vector<IdEdge>>();
 }
 
-template<typename VerticeType, typename EdgeType>
-DerivedGraph<VerticeType, EdgeType>::DerivedGraph(const DerivedGraph<VerticeType, EdgeType>& other) {
-    adjacencyList = other.adjacencyList;
-    graphType = other.graphType;
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+DerivedGraph<VerticeType, EdgeType, TypePolicy>::DerivedGraph(const DerivedGraph<VerticeType, EdgeType, TypePolicy>& other) = default;
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+DerivedGraph<VerticeType, EdgeType, TypePolicy>::DerivedGraph(DerivedGraph<VerticeType, EdgeType, TypePolicy>&& other) noexcept = default;
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+DerivedGraph<VerticeType, EdgeType, TypePolicy>& DerivedGraph<VerticeType, EdgeType, TypePolicy>::operator=(const DerivedGraph<VerticeType, EdgeType, TypePolicy>& other) = default;
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+DerivedGraph<VerticeType, EdgeType, TypePolicy>& DerivedGraph<VerticeType, EdgeType, TypePolicy>::operator=(DerivedGraph<VerticeType, EdgeType, TypePolicy>&& other) = default;
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+typename DerivedGraph<VerticeType, EdgeType, TypePolicy>::VertexId DerivedGraph<VerticeType, EdgeType, TypePolicy>::requireId(const VerticeType &vertex) const {
+    VertexId id = vertices.find(vertex);
+    if (id == VertexInterner<VerticeType>::npos) {
+        throw std::runtime_error("Vertex does not exist in the graph");
+    }
+    return id;
 }
 
-template<typename VerticeType, typename EdgeType>
-DerivedGraph<VerticeType, EdgeType>::DerivedGraph(DerivedGraph<VerticeType, EdgeType>&& other) noexcept {
-    adjacencyList = std::move(other.adjacencyList);
-    graphType = std::move(other.graphType);
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::requireInEdgeIndex() const {
+    if (!inEdgesIndexed) {
+        throw std::runtime_error("In-edge index is disabled for this graph");
+    }
 }
 
-template<typename VerticeType, typename EdgeType>
-DerivedGraph<VerticeType, EdgeType>& DerivedGraph<VerticeType, EdgeType>::operator=(const DerivedGraph<VerticeType, EdgeType>& other) {
-    if (&other != this) {
-        adjacencyList = other.adjacencyList;
-        graphType = other.graphType;
+// Hubs answer from their neighbor set, everyone else scans the edge list
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+bool DerivedGraph<VerticeType, EdgeType, TypePolicy>::linked(VertexId source, VertexId destination) const {
+    const auto &edges = adjacencyList[source];
+    if (edges.size() >= hubThreshold / 2) {
+        auto hub = hubNeighbors.find(source);
+        if (hub != hubNeighbors.end()) {
+            return hub->second.contains(destination);
+        }
+    }
+    auto it = std::find_if(edges.begin(), edges.end(), [destination](const IdEdge &edge) { return edge.first == destination; });
+    GRAPH_METRICS_WORK(AdjacencyScanned, (it - edges.begin()) + (it != edges.end()));
+    return it != edges.end();
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::indexHub(VertexId id) {
+    auto &neighbors = hubNeighbors.try_emplace(id).first->second;
+    neighbors.reserve(adjacencyList[id].size() * 2);
+    for (const auto &edge : adjacencyList[id]) {
+        neighbors.insert(edge.first);
+    }
+}
+
+// Drops source's edge to destination from the adjacency, its hub set and the counters; the in-edge index is left to
+// the caller
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+bool DerivedGraph<VerticeType, EdgeType, TypePolicy>::eraseEdgeTo(VertexId source, VertexId destination) {
+    auto &edges = adjacencyList[source];
+    auto hub = edges.size() >= hubThreshold / 2 ? hubNeighbors.find(source) : hubNeighbors.end();
+    if (hub != hubNeighbors.end() && !hub->second.contains(destination)) {
+        return false;
+    }
+    auto it = std::find_if(edges.begin(), edges.end(), [destination](const IdEdge &edge) { return edge.first == destination; });
+    GRAPH_METRICS_WORK(AdjacencyScanned, (it - edges.begin()) + (it != edges.end()));
+    if (it == edges.end()) {
+        return false;
     }
-    return *this;
+    if (isNegativeWeight(it->second)) {
+        counters.negativeWeightRemoved();
+    }
+    edges.erase(it);
+    counters.degreeChanged(edges.size() + 1, edges.size());
+    if (hub != hubNeighbors.end()) {
+        if (edges.size() < hubThreshold / 2) {
+            hubNeighbors.erase(hub);
+        } else {
+            hub->second.erase(destination);
+        }
+    }
+    return true;
 }
 
-template<typename VerticeType, typename EdgeType>
-DerivedGraph<VerticeType, EdgeType>& DerivedGraph<VerticeType, EdgeType>::operator=(DerivedGraph<VerticeType, EdgeType>&& other) noexcept {
-    if (&other != this) {
-        adjacencyList = std::move(other.adjacencyList);
-        graphType = std::move(other.graphType);
+// Predecessor order carries no meaning, so removal swaps with the last entry
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::erasePredecessor(std::pmr::vector<VertexId> &predecessors, VertexId source) {
+    auto it = std::find(predecessors.begin(), predecessors.end(), source);
+    if (it != predecessors.end()) {
+        *it = predecessors.back();
+        predecessors.pop_back();
     }
-    return *this;
 }
 
-template<typename VerticeType, typename EdgeType>
-void DerivedGraph<VerticeType, EdgeType>::addVertex(const VerticeType& vertex) {
-    if (adjacencyList.find(vertex) != adjacencyList.end()) {
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::addVertex(const VerticeType& vertex) {
+    GRAPH_METRICS_SCOPE(AddVertex);
+    insertVertex(vertex);
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+typename DerivedGraph<VerticeType, EdgeType, TypePolicy>::VertexId DerivedGraph<VerticeType, EdgeType, TypePolicy>::insertVertex(const VerticeType &vertex) {
+    auto inserted = vertices.insert(vertex);
+    if (!inserted.second) {
         throw std::runtime_error("Vertex already exists in the graph");
     }
-    adjacencyList.emplace(vertex, std::vector<std::pair<VerticeType, EdgeType>>());
+    VertexId id = inserted.first;
+    if (id == adjacencyList.size()) {
+        adjacencyList.emplace_back();
+        if (inEdgesIndexed) {
+            predecessorList.emplace_back();
+        }
+        topologicalIndex.push_back(0);
+        searchMark.resize(id + 1);
+    }
+    // A vertex without edges can always go last in the order
+    topologicalIndex[id] = topologicalOrder.size();
+    topologicalOrder.push_back(id);
+    counters.vertexAdded();
+    return id;
 }
 
-template<typename VerticeType, typename EdgeType>
-void DerivedGraph<VerticeType, EdgeType>::removeVertex(const VerticeType &vertex) {
-    auto it = adjacencyList.find(vertex);
-    if (it == adjacencyList.end()) {
-        throw std::runtime_error("Vertex does not exist in the graph");
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::removeVertex(const VerticeType &vertex) {
+    GRAPH_METRICS_SCOPE(RemoveVertex);
+    VertexId id = requireId(vertex);
+    if (inEdgesIndexed) {
+        // Only the vertex's own neighbors refer to it
+        for (VertexId source : predecessorList[id]) {
+            if (source != id) {
+                eraseEdgeTo(source, id);
+            }
+        }
+        for (const auto &edge : adjacencyList[id]) {
+            if (edge.first != id) {
+                erasePredecessor(predecessorList[edge.first], id);
+            }
+        }
+        predecessorList[id].clear();
+        predecessorList[id].shrink_to_fit();
+    } else {
+        for (VertexId other = 0; other < adjacencyList.size(); ++other) {
+            if (other != id) {
+                eraseEdgeTo(other, id);
+            }
+        }
     }
-    adjacencyList.erase(it);
-    for (auto &vertexPair : adjacencyList) {
-        vertexPair.second.erase(
-                std::remove_if(vertexPair.second.begin(), vertexPair.second.end(),
-                               [&vertex](const std::pair<VerticeType, EdgeType>& edgePair) {
-                                   return edgePair.first == vertex;
-                               }),
-                vertexPair.second.end()
-        );
+    counters.vertexRemoved(adjacencyList[id].size());
+    counters.negativeWeightRemoved(std::count_if(adjacencyList[id].begin(), adjacencyList[id].end(),
+                                                 [](const IdEdge &edge) { return isNegativeWeight(edge.second); }));
+    adjacencyList[id].clear();
+    adjacencyList[id].shrink_to_fit();
+    hubNeighbors.erase(id);
+    topologicalOrder[topologicalIndex[id]] = VertexInterner<VerticeType>::npos;
+    if (++deadTopologicalSlots > topologicalOrder.size() / 2 + 64) {
+        compactTopologicalOrder();
     }
+    vertices.erase(id);
 }
 
-template<typename VerticeType, typename EdgeType>
-void DerivedGraph<VerticeType, EdgeType>::addEdge(const VerticeType &source, const VerticeType &destination, const EdgeType &weight, bool checkForCycle) {
-    if (adjacencyList.find(source) == adjacencyList.end() || adjacencyList.find(destination) == adjacencyList.end()) {
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::addEdge(const VerticeType &source, const VerticeType &destination, const EdgeType &weight, bool checkForCycle) {
+    GRAPH_METRICS_SCOPE(AddEdge);
+    VertexId sourceId = vertices.find(source);
+    VertexId destinationId = vertices.find(destination);
+    if (sourceId == VertexInterner<VerticeType>::npos || destinationId == VertexInterner<VerticeType>::npos) {
         throw std::runtime_error("One or both vertices do not exist in the graph");
     }
-    auto& sourceEdges = adjacencyList[source];
-    sourceEdges.reserve(sourceEdges.size() + 1);
-    if (std::any_of(sourceEdges.begin(), sourceEdges.end(), [&destination](const auto& pair) {
-        return pair.first == destination;
-    })) {
+    if (linked(sourceId, destinationId)) {
         throw std::runtime_error("An edge between these vertices already exists.");
     }
-    sourceEdges.emplace_back(destination, weight);
-    if (checkForCycle && this->graphType == DAG) {
-        if (GraphAlgorithms::isCyclic(*this)) {
-            sourceEdges.pop_back();
-            throw std::runtime_error("Edge creation results in a cycle in the graph");
+    if (graphType.type() == DAG) {
+        if (checkForCycle) {
+            // An order broken by unchecked inserts is rebuilt first; if that fails the graph already has a cycle
+            if ((!topologicalOrderValid && !rebuildTopologicalOrder()) || !reorderForEdge(sourceId, destinationId)) {
+                throw std::runtime_error("Edge creation results in a cycle in the graph");
+            }
+        } else if (topologicalIndex[sourceId] >= topologicalIndex[destinationId]) {
+            topologicalOrderValid = false;
+        }
+    }
+    auto& sourceEdges = adjacencyList[sourceId];
+    sourceEdges.emplace_back(destinationId, weight);
+    counters.degreeChanged(sourceEdges.size() - 1, sourceEdges.size());
+    if (isNegativeWeight(weight)) {
+        counters.negativeWeightAdded();
+    }
+    if (sourceEdges.size() >= hubThreshold / 2) {
+        auto hub = hubNeighbors.find(sourceId);
+        if (hub != hubNeighbors.end()) {
+            hub->second.insert(destinationId);
+        } else if (sourceEdges.size() >= hubThreshold) {
+            indexHub(sourceId);
+        }
+    }
+    if (inEdgesIndexed) {
+        predecessorList[destinationId].push_back(sourceId);
+    }
+}
+
+// Marchetti-Spaccamela, Nanni and Rohnert's online topological order. Only an edge that goes against the current
+// order needs work: search forward from destination through the vertices ordered before source. Reaching source
+// means a cycle, otherwise the vertices reached are shifted after source. Returns false (order untouched) on a cycle.
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+bool DerivedGraph<VerticeType, EdgeType, TypePolicy>::reorderForEdge(VertexId source, VertexId destination) {
+    const std::size_t lowerBound = topologicalIndex[destination];
+    const std::size_t upperBound = topologicalIndex[source];
+    if (lowerBound > upperBound) {
+        return true;
+    }
+    std::vector<VertexId> &reached = searchQueue;
+    reached.assign(1, destination);
+    searchMark.set(destination);
+    bool cycle = false;
+    for (std::size_t head = 0; head < reached.size() && !cycle; ++head) {
+        if (reached[head] == source) {
+            cycle = true;
+            break;
+        }
+        for (const auto &edge : adjacencyList[reached[head]]) {
+            // Anything ordered after source cannot lead back to it
+            if (topologicalIndex[edge.first] <= upperBound && !searchMark.testAndSet(edge.first)) {
+                reached.push_back(edge.first);
+            }
+        }
+    }
+
+    if (!cycle) {
+        // Within the affected region keep the unreached vertices first and move the reached ones after source,
+        // preserving relative order inside both groups and reusing the region's live slots.
+        std::vector<std::size_t> &slots = reorderSlots;
+        std::vector<VertexId> &shifted = reorderShifted;
+        std::vector<VertexId> &reordered = reorderKept;
+        slots.clear();
+        shifted.clear();
+        reordered.clear();
+        for (std::size_t position = lowerBound; position <= upperBound; ++position) {
+            VertexId vertex = topologicalOrder[position];
+            if (vertex == VertexInterner<VerticeType>::npos) {
+                continue;
+            }
+            slots.push_back(position);
+            (searchMark.test(vertex) ? shifted : reordered).push_back(vertex);
+        }
+        reordered.insert(reordered.end(), shifted.begin(), shifted.end());
+        for (std::size_t i = 0; i < slots.size(); ++i) {
+            topologicalOrder[slots[i]] = reordered[i];
+            topologicalIndex[reordered[i]] = slots[i];
+        }
+    }
+    for (VertexId vertex : reached) {
+        searchMark.reset(vertex);
+    }
+    GRAPH_METRICS_WORK(VerticesVisited, reached.size());
+    return !cycle;
+}
+
+// Recomputes the order from scratch with Kahn's algorithm. Returns false if the graph holds a cycle.
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+bool DerivedGraph<VerticeType, EdgeType, TypePolicy>::rebuildTopologicalOrder() {
+    std::vector<std::size_t> inDegree(adjacencyList.size(), 0);
+    for (const auto &edges : adjacencyList) {
+        for (const auto &edge : edges) {
+            ++inDegree[edge.first];
+        }
+    }
+    std::vector<VertexId> order;
+    order.reserve(vertices.size());
+    for (VertexId id = 0; id < adjacencyList.size(); ++id) {
+        if (vertices.contains(id) && inDegree[id] == 0) {
+            order.push_back(id);
+        }
+    }
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        for (const auto &edge : adjacencyList[order[head]]) {
+            if (--inDegree[edge.first] == 0) {
+                order.push_back(edge.first);
+            }
         }
     }
+    GRAPH_METRICS_WORK(VerticesVisited, order.size());
+    if (order.size() != vertices.size()) {
+        return false;
+    }
+    topologicalOrder = std::move(order);
+    for (std::size_t position = 0; position < topologicalOrder.size(); ++position) {
+        topologicalIndex[topologicalOrder[position]] = position;
+    }
+    deadTopologicalSlots = 0;
+    topologicalOrderValid = true;
+    return true;
 }
 
-template<typename VerticeType, typename EdgeType>
-void DerivedGraph<VerticeType, EdgeType>::addDirectionalEdge(const VerticeType &source, const VerticeType &destination, const EdgeType &weight, bool isDirected, bool checkForCycle) {
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::compactTopologicalOrder() {
+    std::size_t next = 0;
+    for (VertexId vertex : topologicalOrder) {
+        if (vertex != VertexInterner<VerticeType>::npos) {
+            topologicalIndex[vertex] = next;
+            topologicalOrder[next++] = vertex;
+        }
+    }
+    topologicalOrder.resize(next);
+    deadTopologicalSlots = 0;
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::addDirectionalEdge(const VerticeType &source, const VerticeType &destination, const EdgeType &weight, bool isDirected, bool checkForCycle) {
     addEdge(source, destination, weight, checkForCycle);
     if (!isDirected) {
         addEdge(destination, source, weight, checkForCycle);
     }
 }
 
-template<typename VerticeType, typename EdgeType>
-void DerivedGraph<VerticeType, EdgeType>::removeEdge(const VerticeType& vertex1, const VerticeType& vertex2) {
-    auto it1 = adjacencyList.find(vertex1);
-    auto it2 = adjacencyList.find(vertex2);
-    if (it1 == adjacencyList.end() || it2 == adjacencyList.end()) {
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::removeEdge(const VerticeType& vertex1, const VerticeType& vertex2) {
+    GRAPH_METRICS_SCOPE(RemoveEdge);
+    VertexId id1 = vertices.find(vertex1);
+    VertexId id2 = vertices.find(vertex2);
+    if (id1 == VertexInterner<VerticeType>::npos || id2 == VertexInterner<VerticeType>::npos) {
         throw std::runtime_error("One or both vertices do not exist in the graph");
     }
-    auto& edges1 = it1->second;
-    auto edgeToBeRemoved1 = std::find_if(edges1.begin(), edges1.end(),
-                                         [&vertex2](auto const &edge) { return edge.first == vertex2; });
-    if (edgeToBeRemoved1 != edges1.end()) {
-        edges1.erase(std::remove_if(edges1.begin(), edges1.end(),
-                                    [&vertex2](auto const &edge) { return edge.first == vertex2; }),
-                     edges1.end());
-    } else {
+    if (!eraseEdgeTo(id1, id2)) {
         throw std::runtime_error("Edge does not exist in the graph");
     }
-    auto& edges2 = it2->second;
-    auto edgeToBeRemoved2 = std::find_if(edges2.begin(), edges2.end(),
-                                         [&vertex1](auto const &edge) { return edge.first == vertex1; });
-    if (edgeToBeRemoved2 != edges2.end()) {
-        edges2.erase(std::remove_if(edges2.begin(), edges2.end(),
-                                    [&vertex1](auto const &edge) { return edge.first == vertex1; }),
-                     edges2.end());
+    if (inEdgesIndexed) {
+        erasePredecessor(predecessorList[id2], id1);
+    }
+    if (eraseEdgeTo(id2, id1) && inEdgesIndexed) {
+        erasePredecessor(predecessorList[id1], id2);
     }
 }
 
-template<typename VerticeType, typename EdgeType>
-unsigned int DerivedGraph<VerticeType, EdgeType>::numVertices() const {
-    return adjacencyList.size();
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+unsigned int DerivedGraph<VerticeType, EdgeType, TypePolicy>::numVertices() const {
+    return vertices.size();
 }
 
-template<typename VerticeType, typename EdgeType>
-unsigned int DerivedGraph<VerticeType, EdgeType>::numEdges() const {
-    unsigned int count = 0;
-    for (const auto &vertexPair : adjacencyList) {
-        count += vertexPair.second.size();
-    }
-    return count;
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+unsigned int DerivedGraph<VerticeType, EdgeType, TypePolicy>::numEdges() const {
+    return counters.numEdges();
 }
 
-template<typename VerticeType, typename EdgeType>
-bool DerivedGraph<VerticeType, EdgeType>::hasEdge(const VerticeType &v1, const VerticeType &v2) const {
-    auto it = adjacencyList.find(v1);
-    if (it == adjacencyList.end()) {
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+bool DerivedGraph<VerticeType, EdgeType, TypePolicy>::hasEdge(const VerticeType &v1, const VerticeType &v2) const {
+    GRAPH_METRICS_SCOPE(HasEdge);
+    VertexId id1 = vertices.find(v1);
+    VertexId id2 = vertices.find(v2);
+    if (id1 == VertexInterner<VerticeType>::npos || id2 == VertexInterner<VerticeType>::npos) {
         return false;
     }
-    for (const auto& adjVertex : it->second) {
-        if (adjVertex.first == v2) {
-            return true;
-        }
-    }
-    return false;
+    return linked(id1, id2);
 }
 
-template<typename VerticeType, typename EdgeType>
-DerivedGraph<VerticeType, EdgeType> DerivedGraph<VerticeType, EdgeType>::from_edges(const std::vector<std::tuple<VerticeType, VerticeType, EdgeType>>& edges, GraphType type) {
-    DerivedGraph<VerticeType, EdgeType> g(type);
+// Bulk construction in stages instead of per-edge addEdge: intern every endpoint, count out-degrees so each
+// adjacency vector is allocated exactly once, reject duplicates with one sort over packed (source, destination)
+// keys, append all edges unchecked and validate acyclicity a single time at the end.
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+DerivedGraph<VerticeType, EdgeType, TypePolicy> DerivedGraph<VerticeType, EdgeType, TypePolicy>::from_edges(const std::vector<std::tuple<VerticeType, VerticeType, EdgeType>>& edges, GraphType type,
+                                                std::pmr::memory_resource* resource) {
+    GRAPH_METRICS_SCOPE(FromEdges);
+    DerivedGraph<VerticeType, EdgeType, TypePolicy> g(type, resource);
+    std::vector<std::uint64_t> keys;
+    keys.reserve(edges.size());
     for (const auto& edge : edges) {
-        VerticeType source, destination;
-        EdgeType weight;
-        std::tie(source, destination, weight) = edge;
-        if (g.adjacencyList.find(source) == g.adjacencyList.end()) {
-            g.addVertex(source);
+        VertexId sourceId = g.vertices.insert(std::get<0>(edge)).first;
+        VertexId destinationId = g.vertices.insert(std::get<1>(edge)).first;
+        keys.push_back(static_cast<std::uint64_t>(sourceId) << 32 | destinationId);
+    }
+
+    const VertexId bound = g.vertices.bound();
+    g.adjacencyList.resize(bound);
+    g.topologicalIndex.resize(bound);
+    g.searchMark.resize(bound);
+    std::vector<std::size_t> degree(bound, 0);
+    std::vector<std::size_t> inDegree(g.inEdgesIndexed ? bound : 0, 0);
+    for (std::uint64_t key : keys) {
+        ++degree[key >> 32];
+        if (g.inEdgesIndexed) {
+            ++inDegree[static_cast<VertexId>(key)];
+        }
+    }
+    if (g.inEdgesIndexed) {
+        g.predecessorList.resize(bound);
+    }
+    for (VertexId id = 0; id < bound; ++id) {
+        g.adjacencyList[id].reserve(degree[id]);
+        if (g.inEdgesIndexed) {
+            g.predecessorList[id].reserve(inDegree[id]);
         }
-        if (g.adjacencyList.find(destination) == g.adjacencyList.end()) {
-            g.addVertex(destination);
+        g.topologicalIndex[id] = g.topologicalOrder.size();
+        g.topologicalOrder.push_back(id);
+    }
+
+    std::vector<std::uint64_t> sortedKeys(keys);
+    Sorting::radixSort(sortedKeys.begin(), sortedKeys.end());
+    if (std::adjacent_find(sortedKeys.begin(), sortedKeys.end()) != sortedKeys.end()) {
+        throw std::runtime_error("An edge between these vertices already exists.");
+    }
+
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        g.adjacencyList[keys[i] >> 32].emplace_back(static_cast<VertexId>(keys[i]), std::get<2>(edges[i]));
+        if (g.inEdgesIndexed) {
+            g.predecessorList[static_cast<VertexId>(keys[i])].push_back(static_cast<VertexId>(keys[i] >> 32));
+        }
+        if (isNegativeWeight(std::get<2>(edges[i]))) {
+            g.counters.negativeWeightAdded();
+        }
+    }
+    for (VertexId id = 0; id < bound; ++id) {
+        g.counters.vertexAdded(degree[id]);
+        if (degree[id] >= hubThreshold) {
+            g.indexHub(id);
         }
-        g.addEdge(source, destination, weight, true);
+    }
+    if (g.graphType.type() == DAG && !g.rebuildTopologicalOrder()) {
+        throw std::runtime_error("Edge creation results in a cycle in the graph: "
+                                 + GraphAlgorithms::describeCycle(GraphAlgorithms::findCycle(g)));
     }
     return g;
 }
 
-template<typename VerticeType, typename EdgeType>
-std::vector<VerticeType> DerivedGraph<VerticeType, EdgeType>::getVertices() const {
-    std::vector<VerticeType> vertices;
-    vertices.reserve(adjacencyList.size());
-    for (const auto& pair : adjacencyList) {
-        vertices.push_back(pair.first);
+// Validation sees the graph as the batch will leave it without touching it. Added vertices get provisional ids from
+// idBound() up, so survivors and newcomers share one id space for the duplicate and cycle checks. A DAG whose
+// current order already has every new edge pointing forward (newcomers appended in batch order) needs no search;
+// otherwise one Kahn pass over the resulting graph both proves it acyclic and becomes its new order. Only once all
+// of that passed are the changes applied, and that part cannot fail short of running out of memory.
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void DerivedGraph<VerticeType, EdgeType, TypePolicy>::Batch::commit() {
+    GRAPH_METRICS_SCOPE(CommitBatch);
+    DerivedGraph &g = *graph;
+    constexpr VertexId npos = VertexInterner<VerticeType>::npos;
+    const VertexId bound = g.vertices.bound();
+    if (static_cast<std::uint64_t>(bound) + addedVertices.size() >= npos) {
+        throw std::runtime_error("Vertex id space exhausted");
+    }
+
+    FlatHashSet<std::uint64_t> droppedEdges;
+    for (const auto &edge : removedEdges) {
+        VertexId first = g.vertices.find(edge.first);
+        VertexId second = g.vertices.find(edge.second);
+        if (first == npos || second == npos) {
+            throw std::runtime_error("One or both vertices do not exist in the graph");
+        }
+        if (!g.linked(first, second) || !droppedEdges.insert(edgeKey(first, second))) {
+            throw std::runtime_error("Edge does not exist in the graph");
+        }
+        if (g.linked(second, first)) {
+            droppedEdges.insert(edgeKey(second, first));
+        }
+    }
+    DenseBitset droppedVertices(bound);
+    for (const VerticeType &vertex : removedVertices) {
+        VertexId id = g.vertices.find(vertex);
+        if (id == npos || droppedVertices.testAndSet(id)) {
+            throw std::runtime_error("Vertex does not exist in the graph");
+        }
+    }
+    FlatHashMap<VerticeType, VertexId> addedIds(addedVertices.size());
+    for (std::size_t i = 0; i < addedVertices.size(); ++i) {
+        VertexId id = g.vertices.find(addedVertices[i]);
+        if ((id != npos && !droppedVertices.test(id))
+            || !addedIds.try_emplace(addedVertices[i], static_cast<VertexId>(bound + i)).second) {
+            throw std::runtime_error("Vertex already exists in the graph");
+        }
+    }
+    auto resolve = [&](const VerticeType &vertex) {
+        auto added = addedIds.find(vertex);
+        if (added != addedIds.end()) {
+            return added->second;
+        }
+        VertexId id = g.vertices.find(vertex);
+        if (id == npos || droppedVertices.test(id)) {
+            throw std::runtime_error("One or both vertices do not exist in the graph");
+        }
+        return id;
+    };
+
+    std::vector<std::uint64_t> keys;
+    keys.reserve(addedEdges.size());
+    for (const auto &edge : addedEdges) {
+        VertexId source = resolve(std::get<0>(edge));
+        VertexId destination = resolve(std::get<1>(edge));
+        if (source < bound && destination < bound && g.linked(source, destination)
+            && !droppedEdges.contains(edgeKey(source, destination))) {
+            throw std::runtime_error("An edge between these vertices already exists.");
+        }
+        keys.push_back(edgeKey(source, destination));
+    }
+
+    // Batch edges grouped by source, batch order kept within a group. A batch that is large next to the graph is
+    // bucketed by a counting sort, which also yields the per-source offsets the cycle check walks; a small one is
+    // sorted so its cost stays independent of the graph's size.
+    const std::size_t total = bound + addedVertices.size();
+    std::vector<std::size_t> bySource(keys.size());
+    std::vector<std::size_t> sourceOffsets;
+    auto bucketBySource = [&]() {
+        sourceOffsets.assign(total + 1, 0);
+        for (std::uint64_t key : keys) {
+            ++sourceOffsets[(key >> 32) + 1];
+        }
+        for (std::size_t id = 0; id < total; ++id) {
+            sourceOffsets[id + 1] += sourceOffsets[id];
+        }
+        std::vector<std::size_t> cursor(sourceOffsets.begin(), sourceOffsets.end() - 1);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            bySource[cursor[keys[i] >> 32]++] = i;
+        }
+    };
+    if (keys.size() >= total / 4) {
+        bucketBySource();
+    } else {
+        for (std::size_t i = 0; i < bySource.size(); ++i) {
+            bySource[i] = i;
+        }
+        std::stable_sort(bySource.begin(), bySource.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] >> 32 < keys[b] >> 32; });
+    }
+    auto groupEnd = [&](std::size_t first) {
+        std::size_t last = first;
+        while (last < bySource.size() && keys[bySource[last]] >> 32 == keys[bySource[first]] >> 32) {
+            ++last;
+        }
+        return last;
+    };
+    std::vector<VertexId> destinations;
+    for (std::size_t first = 0, last; first < bySource.size(); first = last) {
+        last = groupEnd(first);
+        destinations.clear();
+        for (std::size_t i = first; i < last; ++i) {
+            destinations.push_back(static_cast<VertexId>(keys[bySource[i]]));
+        }
+        std::sort(destinations.begin(), destinations.end());
+        if (std::adjacent_find(destinations.begin(), destinations.end()) != destinations.end()) {
+            throw std::runtime_error("An edge between these vertices already exists.");
+        }
+    }
+
+    std::vector<VertexId> order;  // Provisional ids; stays empty when the current order can simply be extended
+    if (g.graphType.type() == DAG && !keys.empty()) {
+        auto position = [&](VertexId id) {
+            return id < bound ? g.topologicalIndex[id] : g.topologicalOrder.size() + (id - bound);
+        };
+        const bool forward = g.topologicalOrderValid && std::all_of(keys.begin(), keys.end(), [&](std::uint64_t key) {
+            return position(static_cast<VertexId>(key >> 32)) < position(static_cast<VertexId>(key));
+        });
+        if (!forward) {
+            auto live = [&](VertexId id) { return id >= bound || (g.vertices.contains(id) && !droppedVertices.test(id)); };
+            auto survives = [&](VertexId source, VertexId destination) {
+                return !droppedVertices.test(destination) && (droppedEdges.empty() || !droppedEdges.contains(edgeKey(source, destination)));
+            };
+            if (sourceOffsets.empty()) {
+                bucketBySource();
+            }
+            std::vector<std::size_t> inDegree(total, 0);
+            for (std::uint64_t key : keys) {
+                ++inDegree[static_cast<VertexId>(key)];
+            }
+            for (VertexId id = 0; id < bound; ++id) {
+                if (live(id)) {
+                    for (const auto &edge : g.adjacencyList[id]) {
+                        inDegree[edge.first] += survives(id, edge.first);
+                    }
+                }
+            }
+            order.reserve(g.vertices.size() - removedVertices.size() + addedVertices.size());
+            for (VertexId id = 0; id < total; ++id) {
+                if (live(id) && inDegree[id] == 0) {
+                    order.push_back(id);
+                }
+            }
+            for (std::size_t head = 0; head < order.size(); ++head) {
+                const VertexId id = order[head];
+                if (id < bound) {
+                    for (const auto &edge : g.adjacencyList[id]) {
+                        if (survives(id, edge.first) && --inDegree[edge.first] == 0) {
+                            order.push_back(edge.first);
+                        }
+                    }
+                }
+                for (std::size_t i = sourceOffsets[id]; i < sourceOffsets[id + 1]; ++i) {
+                    const VertexId target = static_cast<VertexId>(keys[bySource[i]]);
+                    if (--inDegree[target] == 0) {
+                        order.push_back(target);
+                    }
+                }
+            }
+            if (order.size() != g.vertices.size() - removedVertices.size() + addedVertices.size()) {
+                throw std::runtime_error("Edge creation results in a cycle in the graph");
+            }
+        }
+    }
+
+    for (const auto &edge : removedEdges) {
+        g.removeEdge(edge.first, edge.second);
+    }
+    for (const VerticeType &vertex : removedVertices) {
+        g.removeVertex(vertex);
+    }
+    g.vertices.reserve(g.vertices.size() + addedVertices.size());
+    g.adjacencyList.reserve(total);
+    std::vector<VertexId> realIds;
+    realIds.reserve(addedVertices.size());
+    for (const VerticeType &vertex : addedVertices) {
+        realIds.push_back(g.insertVertex(vertex));
+    }
+    auto real = [&](VertexId id) { return id < bound ? id : realIds[id - bound]; };
+
+    if (g.inEdgesIndexed && !sourceOffsets.empty()) {
+        std::vector<std::size_t> addedInEdges(total, 0);
+        for (std::uint64_t key : keys) {
+            ++addedInEdges[static_cast<VertexId>(key)];
+        }
+        for (VertexId id = 0; id < total; ++id) {
+            if (addedInEdges[id] != 0) {
+                auto &predecessors = g.predecessorList[real(id)];
+                predecessors.reserve(predecessors.size() + addedInEdges[id]);
+            }
+        }
+    }
+    // One group per source, so every list grows once
+    for (std::size_t first = 0, last; first < bySource.size(); first = last) {
+        last = groupEnd(first);
+        const VertexId source = real(static_cast<VertexId>(keys[bySource[first]] >> 32));
+        auto &edges = g.adjacencyList[source];
+        const std::size_t before = edges.size();
+        edges.reserve(before + (last - first));
+        for (std::size_t i = first; i < last; ++i) {
+            const EdgeType &weight = std::get<2>(addedEdges[bySource[i]]);
+            const VertexId destination = real(static_cast<VertexId>(keys[bySource[i]]));
+            edges.emplace_back(destination, weight);
+            if (isNegativeWeight(weight)) {
+                g.counters.negativeWeightAdded();
+            }
+            if (g.inEdgesIndexed) {
+                g.predecessorList[destination].push_back(source);
+            }
+        }
+        g.counters.degreeChanged(before, edges.size());
+        if (edges.size() >= hubThreshold / 2) {
+            auto hub = g.hubNeighbors.find(source);
+            if (hub != g.hubNeighbors.end()) {
+                for (std::size_t i = before; i < edges.size(); ++i) {
+                    hub->second.insert(edges[i].first);
+                }
+            } else if (edges.size() >= hubThreshold) {
+                g.indexHub(source);
+            }
+        }
+    }
+
+    if (!order.empty()) {
+        g.topologicalOrder.clear();
+        for (VertexId id : order) {
+            g.topologicalIndex[real(id)] = g.topologicalOrder.size();
+            g.topologicalOrder.push_back(real(id));
+        }
+        g.deadTopologicalSlots = 0;
+        g.topologicalOrderValid = true;
+    }
+    addedVertices.clear();
+    removedVertices.clear();
+    addedEdges.clear();
+    removedEdges.clear();
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+std::vector<VerticeType> DerivedGraph<VerticeType, EdgeType, TypePolicy>::getVertices() const {
+    std::vector<VerticeType> result;
+    result.reserve(vertices.size());
+    for (VertexId id = 0; id < vertices.bound(); ++id) {
+        if (vertices.contains(id)) {
+            result.push_back(vertices.value(id));
+        }
+    }
+    return result;
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+CSRGraph<VerticeType, EdgeType> DerivedGraph<VerticeType, EdgeType, TypePolicy>::freeze(bool withInEdges) const {
+    GRAPH_METRICS_SCOPE(Freeze);
+    // Recycled ids can leave holes; the snapshot renumbers the live ones densely in id order
+    std::vector<VertexId> denseIds(vertices.bound(), VertexInterner<VerticeType>::npos);
+    std::vector<VerticeType> denseVertices;
+    denseVertices.reserve(vertices.size());
+    std::vector<std::size_t> offsets(1, 0);
+    offsets.reserve(vertices.size() + 1);
+    for (VertexId id = 0; id < vertices.bound(); ++id) {
+        if (vertices.contains(id)) {
+            denseIds[id] = static_cast<VertexId>(denseVertices.size());
+            denseVertices.push_back(vertices.value(id));
+            offsets.push_back(offsets.back() + adjacencyList[id].size());
+        }
     }
-    return vertices;
+    std::vector<VertexId> targets;
+    std::vector<EdgeType> weights;
+    targets.reserve(offsets.back());
+    weights.reserve(offsets.back());
+    for (VertexId id = 0; id < vertices.bound(); ++id) {
+        for (const auto &edge : adjacencyList[id]) {
+            targets.push_back(denseIds[edge.first]);
+            weights.push_back(edge.second);
+        }
+    }
+    return CSRGraph<VerticeType, EdgeType>(std::move(denseVertices), std::move(offsets), std::move(targets), std::move(weights), withInEdges);
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+typename DerivedGraph<VerticeType, EdgeType, TypePolicy>::AdjacentIterator DerivedGraph<VerticeType, EdgeType, TypePolicy>::adjacentBegin(const VerticeType& vertex) {
+    return AdjacentIterator(adjacencyList[requireId(vertex)].begin(), &vertices);
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+typename DerivedGraph<VerticeType, EdgeType, TypePolicy>::AdjacentIterator DerivedGraph<VerticeType, EdgeType, TypePolicy>::adjacentEnd(const VerticeType& vertex) {
+    return AdjacentIterator(adjacencyList[requireId(vertex)].end(), &vertices);
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+std::size_t DerivedGraph<VerticeType, EdgeType, TypePolicy>::inDegree(const VerticeType& vertex) const {
+    return predecessorIds(requireId(vertex)).size();
 }
 
-template<typename VerticeType, typename EdgeType>
-auto DerivedGraph<VerticeType, EdgeType>::adjacentBegin(const VerticeType& vertex) -> typename decltype(adjacencyList)::mapped_type::iterator {
-    return adjacencyList[vertex].begin();
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+typename DerivedGraph<VerticeType, EdgeType, TypePolicy>::PredecessorIterator DerivedGraph<VerticeType, EdgeType, TypePolicy>::predecessorsBegin(const VerticeType& vertex) const {
+    return PredecessorIterator(predecessorIds(requireId(vertex)).begin(), &vertices);
 }
 
-template<typename VerticeType, typename EdgeType>
-auto DerivedGraph<VerticeType, EdgeType>::adjacentEnd(const VerticeType& vertex) -> typename decltype(adjacencyList)::mapped_type::iterator {
-    return adjacencyList[vertex].end();
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+typename DerivedGraph<VerticeType, EdgeType, TypePolicy>::PredecessorIterator DerivedGraph<VerticeType, EdgeType, TypePolicy>::predecessorsEnd(const VerticeType& vertex) const {
+    return PredecessorIterator(predecessorIds(requireId(vertex)).end(), &vertices);
 }
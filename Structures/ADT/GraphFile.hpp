@@ -0,0 +1,103 @@
+// Created by Aaron H on 5/28/24.
+#ifndef GRAPHFILE_HPP
+#define GRAPHFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "Graph.hpp"
+#include "MappedFile.hpp"
+
+// On-disk CSR layout: this header, then 64-byte aligned sections holding the vertex table, a vertex index sorted by
+// value (for idOf), row offsets, column targets, edge weights and, optionally, the in-edge offsets and sources.
+// Everything is stored in host byte order exactly as it sits in memory, so loading is a single mmap.
+struct GraphFileHeader {
+    static constexpr char expectedMagic[8] = {'U', 'A', 'G', 'R', 'A', 'P', 'H', '\0'};
+    static constexpr std::uint32_t currentVersion = 1;
+    static constexpr std::uint32_t byteOrderMark = 0x01020304;
+    static constexpr std::uint64_t sectionAlignment = 64;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t vertexSize;
+    std::uint32_t edgeSize;
+    std::uint64_t numVertices;
+    std::uint64_t numEdges;
+    std::uint64_t fileSize;
+    std::uint64_t verticesOffset;
+    std::uint64_t sortedIndexOffset;
+    std::uint64_t offsetsOffset;
+    std::uint64_t targetsOffset;
+    std::uint64_t weightsOffset;
+    std::uint64_t inOffsetsOffset;  // Both 0 when the file was written without in-edges
+    std::uint64_t inSourcesOffset;
+};
+
+// Writes a frozen graph to path, replacing any existing file. VerticeType and EdgeType must be trivially copyable
+// since their bytes are stored verbatim; VerticeType also needs operator< for the sorted vertex index.
+template<typename VerticeType, typename EdgeType>
+void writeGraphFile(const CSRGraph<VerticeType, EdgeType>& graph, const std::string& path);
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void writeGraphFile(const DerivedGraph<VerticeType, EdgeType, TypePolicy>& graph, const std::string& path, bool withInEdges = false);
+
+// Read-only CSR view over a memory-mapped graph file. Opening validates the header, the section bounds and the first
+// and last row offsets, nothing else is parsed or copied: pages are faulted in on first touch and processes mapping
+// the same file share them. Files from untrusted sources should also pass verify() before use.
+// Offers the same id-level interface as CSRGraph, so DFSEngine and friends run on it unchanged.
+template<typename VerticeType, typename EdgeType>
+class MappedCSRGraph {
+    static_assert(std::is_trivially_copyable<VerticeType>::value && std::is_trivially_copyable<EdgeType>::value,
+                  "Graph files store vertices and weights as raw bytes");
+public:
+    using VertexId = std::uint32_t;
+    using Weight = EdgeType;
+
+    explicit MappedCSRGraph(const std::string& path);
+
+    // Full scan of every section, linear in the file size: row offsets never decrease, every target and in-edge
+    // source names a vertex, and the sorted index holds valid ids in ascending vertex order. Throws
+    // std::runtime_error on the first violation, so corrupt files fail here instead of reading out of bounds later.
+    void verify() const;
+
+    [[nodiscard]] unsigned int numVertices() const { return static_cast<unsigned int>(header().numVertices); }
+    [[nodiscard]] unsigned int numEdges() const { return static_cast<unsigned int>(header().numEdges); }
+
+    bool hasVertex(const VerticeType &vertex) const;
+    bool hasEdge(const VerticeType &v1, const VerticeType &v2) const;
+
+    // Binary search over the sorted vertex index
+    VertexId idOf(const VerticeType &vertex) const;
+    const VerticeType& vertexOf(VertexId id) const { return vertices[id]; }
+
+    [[nodiscard]] VertexId idBound() const { return numVertices(); }
+    [[nodiscard]] bool containsId(VertexId id) const { return id < header().numVertices; }
+    [[nodiscard]] std::size_t outDegree(VertexId id) const { return offsets[id + 1] - offsets[id]; }
+    [[nodiscard]] VertexId neighborAt(VertexId id, std::size_t index) const { return targets[offsets[id] + index]; }
+    const VertexId* neighborsBegin(VertexId id) const { return targets + offsets[id]; }
+    const VertexId* neighborsEnd(VertexId id) const { return targets + offsets[id + 1]; }
+    const EdgeType* weightsBegin(VertexId id) const { return weights + offsets[id]; }
+
+    [[nodiscard]] bool hasInEdges() const { return inOffsets != nullptr; }
+    [[nodiscard]] std::size_t inDegree(VertexId id) const { return inOffsets[id + 1] - inOffsets[id]; }
+    const VertexId* inNeighborsBegin(VertexId id) const { return inSources + inOffsets[id]; }
+    const VertexId* inNeighborsEnd(VertexId id) const { return inSources + inOffsets[id + 1]; }
+
+private:
+    MappedFile file;
+    const VerticeType* vertices = nullptr;
+    const VertexId* sortedIndex = nullptr;
+    const std::uint64_t* offsets = nullptr;
+    const VertexId* targets = nullptr;
+    const EdgeType* weights = nullptr;
+    const std::uint64_t* inOffsets = nullptr;
+    const VertexId* inSources = nullptr;
+
+    VertexId find(const VerticeType &vertex) const;
+    const GraphFileHeader& header() const { return *reinterpret_cast<const GraphFileHeader*>(file.data()); }
+};
+#include "GraphFile.tpp"
+#endif
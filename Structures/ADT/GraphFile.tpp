@@ -0,0 +1,192 @@
+#include "GraphFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace GraphFileDetail {
+
+    inline std::uint64_t alignSection(std::uint64_t offset) {
+        return (offset + GraphFileHeader::sectionAlignment - 1) / GraphFileHeader::sectionAlignment
+               * GraphFileHeader::sectionAlignment;
+    }
+
+    // Appends count elements at the next aligned offset, zero-filling the gap
+    template<typename T>
+    std::uint64_t writeSection(std::ofstream& out, std::uint64_t& position, const T* data, std::size_t count) {
+        static const char padding[GraphFileHeader::sectionAlignment] = {};
+        const std::uint64_t start = alignSection(position);
+        out.write(padding, static_cast<std::streamsize>(start - position));
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        position = start + count * sizeof(T);
+        return start;
+    }
+
+    template<typename T>
+    const T* sectionAt(const char* base, std::uint64_t fileSize, std::uint64_t offset, std::uint64_t count) {
+        if (offset % alignof(T) != 0 || offset > fileSize || count > (fileSize - offset) / sizeof(T)) {
+            throw std::runtime_error("Graph file section lies outside the file");
+        }
+        return reinterpret_cast<const T*>(base + offset);
+    }
+
+    // Rows of a CSR section: offsets never decrease and every column names one of vertices
+    inline void verifyRows(const std::uint64_t* offsets, const std::uint32_t* columns, std::uint64_t vertices, const char* section) {
+        // With the endpoints checked on open, non-decreasing offsets keep every row inside the column section
+        for (std::uint64_t row = 0; row < vertices; ++row) {
+            if (offsets[row] > offsets[row + 1]) {
+                throw std::runtime_error(std::string("Graph file ") + section + " offsets decrease at vertex " + std::to_string(row));
+            }
+        }
+        for (std::uint64_t row = 0; row < vertices; ++row) {
+            for (std::uint64_t index = offsets[row]; index < offsets[row + 1]; ++index) {
+                if (columns[index] >= vertices) {
+                    throw std::runtime_error(std::string("Graph file ") + section + " of vertex " + std::to_string(row)
+                                             + " names a missing vertex");
+                }
+            }
+        }
+    }
+
+}  // namespace GraphFileDetail
+
+template<typename VerticeType, typename EdgeType>
+void writeGraphFile(const CSRGraph<VerticeType, EdgeType>& graph, const std::string& path) {
+    static_assert(std::is_trivially_copyable<VerticeType>::value && std::is_trivially_copyable<EdgeType>::value,
+                  "Graph files store vertices and weights as raw bytes");
+    using VertexId = typename CSRGraph<VerticeType, EdgeType>::VertexId;
+    const std::size_t n = graph.numVertices();
+
+    std::vector<VerticeType> vertices;
+    vertices.reserve(n);
+    for (VertexId id = 0; id < n; ++id) {
+        vertices.push_back(graph.vertexOf(id));
+    }
+    std::vector<VertexId> sortedIndex(n);
+    std::iota(sortedIndex.begin(), sortedIndex.end(), 0);
+    std::sort(sortedIndex.begin(), sortedIndex.end(), [&vertices](VertexId a, VertexId b) { return vertices[a] < vertices[b]; });
+    std::vector<std::uint64_t> offsets(graph.rowOffsets().begin(), graph.rowOffsets().end());
+    std::vector<std::uint64_t> inOffsets(graph.inRowOffsets().begin(), graph.inRowOffsets().end());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Cannot open graph file for writing: " + path);
+    }
+    GraphFileHeader header{};
+    std::memcpy(header.magic, GraphFileHeader::expectedMagic, sizeof(header.magic));
+    header.version = GraphFileHeader::currentVersion;
+    header.byteOrder = GraphFileHeader::byteOrderMark;
+    header.vertexSize = sizeof(VerticeType);
+    header.edgeSize = sizeof(EdgeType);
+    header.numVertices = n;
+    header.numEdges = graph.numEdges();
+    // Written once as a placeholder and again once the section offsets are known
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::uint64_t position = sizeof(header);
+    header.verticesOffset = GraphFileDetail::writeSection(out, position, vertices.data(), vertices.size());
+    header.sortedIndexOffset = GraphFileDetail::writeSection(out, position, sortedIndex.data(), sortedIndex.size());
+    header.offsetsOffset = GraphFileDetail::writeSection(out, position, offsets.data(), offsets.size());
+    header.targetsOffset = GraphFileDetail::writeSection(out, position, graph.columnTargets().data(), graph.columnTargets().size());
+    header.weightsOffset = GraphFileDetail::writeSection(out, position, graph.edgeWeights().data(), graph.edgeWeights().size());
+    if (graph.hasInEdges()) {
+        header.inOffsetsOffset = GraphFileDetail::writeSection(out, position, inOffsets.data(), inOffsets.size());
+        header.inSourcesOffset = GraphFileDetail::writeSection(out, position, graph.inColumnSources().data(), graph.inColumnSources().size());
+    }
+    header.fileSize = position;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!out.flush()) {
+        throw std::runtime_error("Failed writing graph file: " + path);
+    }
+}
+
+template<typename VerticeType, typename EdgeType, typename TypePolicy>
+void writeGraphFile(const DerivedGraph<VerticeType, EdgeType, TypePolicy>& graph, const std::string& path, bool withInEdges) {
+    writeGraphFile(graph.freeze(withInEdges), path);
+}
+
+template<typename VerticeType, typename EdgeType>
+MappedCSRGraph<VerticeType, EdgeType>::MappedCSRGraph(const std::string& path) : file(path) {
+    if (file.size() < sizeof(GraphFileHeader)) {
+        throw std::runtime_error("Graph file is truncated: " + path);
+    }
+    const GraphFileHeader& h = header();
+    if (std::memcmp(h.magic, GraphFileHeader::expectedMagic, sizeof(h.magic)) != 0) {
+        throw std::runtime_error("Not a graph file: " + path);
+    }
+    if (h.version != GraphFileHeader::currentVersion) {
+        throw std::runtime_error("Unsupported graph file version " + std::to_string(h.version));
+    }
+    if (h.byteOrder != GraphFileHeader::byteOrderMark) {
+        throw std::runtime_error("Graph file was written with a different byte order");
+    }
+    if (h.vertexSize != sizeof(VerticeType) || h.edgeSize != sizeof(EdgeType)) {
+        throw std::runtime_error("Graph file vertex or weight type does not match");
+    }
+    if (h.fileSize != file.size() || h.numVertices >= VertexInterner<VerticeType>::npos) {
+        throw std::runtime_error("Graph file header is corrupt");
+    }
+    vertices = GraphFileDetail::sectionAt<VerticeType>(file.data(), file.size(), h.verticesOffset, h.numVertices);
+    sortedIndex = GraphFileDetail::sectionAt<VertexId>(file.data(), file.size(), h.sortedIndexOffset, h.numVertices);
+    offsets = GraphFileDetail::sectionAt<std::uint64_t>(file.data(), file.size(), h.offsetsOffset, h.numVertices + 1);
+    targets = GraphFileDetail::sectionAt<VertexId>(file.data(), file.size(), h.targetsOffset, h.numEdges);
+    weights = GraphFileDetail::sectionAt<EdgeType>(file.data(), file.size(), h.weightsOffset, h.numEdges);
+    if (offsets[0] != 0 || offsets[h.numVertices] != h.numEdges) {
+        throw std::runtime_error("Graph file row offsets are corrupt");
+    }
+    if (h.inOffsetsOffset != 0) {
+        inOffsets = GraphFileDetail::sectionAt<std::uint64_t>(file.data(), file.size(), h.inOffsetsOffset, h.numVertices + 1);
+        inSources = GraphFileDetail::sectionAt<VertexId>(file.data(), file.size(), h.inSourcesOffset, h.numEdges);
+        if (inOffsets[0] != 0 || inOffsets[h.numVertices] != h.numEdges) {
+            throw std::runtime_error("Graph file in-edge offsets are corrupt");
+        }
+    }
+}
+
+template<typename VerticeType, typename EdgeType>
+void MappedCSRGraph<VerticeType, EdgeType>::verify() const {
+    const std::uint64_t n = header().numVertices;
+    GraphFileDetail::verifyRows(offsets, targets, n, "edge");
+    if (hasInEdges()) {
+        GraphFileDetail::verifyRows(inOffsets, inSources, n, "in-edge");
+    }
+    for (std::uint64_t rank = 0; rank < n; ++rank) {
+        if (sortedIndex[rank] >= n || (rank > 0 && vertices[sortedIndex[rank]] < vertices[sortedIndex[rank - 1]])) {
+            throw std::runtime_error("Graph file vertex index is corrupt");
+        }
+    }
+}
+
+// Binary search over the sorted vertex index; npos when absent
+template<typename VerticeType, typename EdgeType>
+typename MappedCSRGraph<VerticeType, EdgeType>::VertexId MappedCSRGraph<VerticeType, EdgeType>::find(const VerticeType &vertex) const {
+    const VertexId* end = sortedIndex + header().numVertices;
+    const VertexId* it = std::lower_bound(sortedIndex, end, vertex, [this](VertexId id, const VerticeType& value) {
+        return vertices[id] < value;
+    });
+    return it == end || vertex < vertices[*it] ? VertexInterner<VerticeType>::npos : *it;
+}
+
+template<typename VerticeType, typename EdgeType>
+bool MappedCSRGraph<VerticeType, EdgeType>::hasVertex(const VerticeType &vertex) const {
+    return find(vertex) != VertexInterner<VerticeType>::npos;
+}
+
+template<typename VerticeType, typename EdgeType>
+typename MappedCSRGraph<VerticeType, EdgeType>::VertexId MappedCSRGraph<VerticeType, EdgeType>::idOf(const VerticeType &vertex) const {
+    VertexId id = find(vertex);
+    if (id == VertexInterner<VerticeType>::npos) {
+        throw std::runtime_error("Vertex does not exist in the graph");
+    }
+    return id;
+}
+
+template<typename VerticeType, typename EdgeType>
+bool MappedCSRGraph<VerticeType, EdgeType>::hasEdge(const VerticeType &v1, const VerticeType &v2) const {
+    VertexId source = find(v1);
+    VertexId destination = find(v2);
+    if (source == VertexInterner<VerticeType>::npos || destination == VertexInterner<VerticeType>::npos) {
+        return false;
+    }
+    return std::find(neighborsBegin(source), neighborsEnd(source), destination) != neighborsEnd(source);
+}
@@ -0,0 +1,342 @@
+// Created by Aaron H on 5/28/24.
+#ifndef GRAPHMETRICS_HPP
+#define GRAPHMETRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Opt-in operation metrics: call counts, latency histograms and work counters per graph operation. The hooks below
+// expand to nothing unless GRAPH_INSTRUMENTATION is defined (the CMake option of the same name), so a normal build
+// carries no trace of them and snapshot() just reports zeros. Each thread records into its own shard with plain
+// relaxed stores; snapshot() sums the shards, and a shard outlives its thread so no counts are lost.
+#if defined(GRAPH_INSTRUMENTATION)
+#define GRAPH_METRICS_SCOPE(operation) GraphMetrics::OperationScope graphMetricsScope(GraphMetrics::Operation::operation)
+#define GRAPH_METRICS_WORK(work, amount) GraphMetrics::recordWork(GraphMetrics::Work::work, static_cast<std::uint64_t>(amount))
+#else
+#define GRAPH_METRICS_SCOPE(operation) static_cast<void>(0)
+#define GRAPH_METRICS_WORK(work, amount) static_cast<void>(0)
+#endif
+
+namespace GraphMetrics {
+
+    enum class Operation : std::size_t {
+        AddVertex, RemoveVertex, AddEdge, RemoveEdge, HasEdge, CommitBatch, FromEdges, Freeze, IsCyclic,
+        Other  // Work recorded outside any instrumented operation
+    };
+    constexpr std::size_t operationCount = static_cast<std::size_t>(Operation::Other) + 1;
+
+    // Counted against the innermost operation in progress, so a cycle check inside addEdge is addEdge's work
+    enum class Work : std::size_t {
+        AdjacencyScanned,  // Edge list entries compared by membership tests and edge removal
+        VerticesVisited,   // Vertices reached by cycle checks and topological order rebuilds
+        Rehashes           // Growth of the vertex-to-id table
+    };
+    constexpr std::size_t workCount = static_cast<std::size_t>(Work::Rehashes) + 1;
+
+    inline const char* name(Operation operation) {
+        static constexpr const char* names[operationCount] = {"addVertex", "removeVertex", "addEdge", "removeEdge", "hasEdge",
+                                                              "commitBatch", "fromEdges", "freeze", "isCyclic", "other"};
+        return names[static_cast<std::size_t>(operation)];
+    }
+
+    inline const char* name(Work work) {
+        static constexpr const char* names[workCount] = {"adjacencyScanned", "verticesVisited", "rehashes"};
+        return names[static_cast<std::size_t>(work)];
+    }
+
+    // Log-linear histogram in the HDR layout: every power of two is split into 16 equal sub-buckets, so values are
+    // exact below 16 and any recorded value is reported within 1/16 of itself, over the whole 64-bit range.
+    class LatencyHistogram {
+    public:
+        static constexpr unsigned subBucketBits = 4;
+        static constexpr std::size_t subBuckets = std::size_t{1} << subBucketBits;
+        static constexpr std::size_t bucketCount = (64 - subBucketBits + 1) * subBuckets;
+
+        static std::size_t bucketOf(std::uint64_t value);
+        // Largest value that lands in bucket
+        static std::uint64_t bucketLimit(std::size_t bucket);
+
+        void record(std::uint64_t value, std::uint64_t times = 1) { add(bucketOf(value), times); }
+        void add(std::size_t bucket, std::uint64_t times) {
+            counts[bucket] += times;
+            total += times;
+        }
+        void merge(const LatencyHistogram& other);
+
+        [[nodiscard]] std::uint64_t count() const { return total; }
+        [[nodiscard]] std::uint64_t countAt(std::size_t bucket) const { return counts[bucket]; }
+        // Upper bound of the bucket holding the value at fraction (0..1] of the recorded ones, 0 when empty
+        [[nodiscard]] std::uint64_t percentile(double fraction) const;
+        [[nodiscard]] std::uint64_t max() const { return percentile(1.0); }
+
+    private:
+        std::array<std::uint64_t, bucketCount> counts{};
+        std::uint64_t total = 0;
+    };
+
+    struct OperationMetrics {
+        std::uint64_t calls = 0;
+        std::uint64_t totalNanos = 0;
+        LatencyHistogram latencyNanos;
+        std::array<std::uint64_t, workCount> work{};
+
+        [[nodiscard]] std::uint64_t workOf(Work kind) const { return work[static_cast<std::size_t>(kind)]; }
+    };
+
+    struct Snapshot {
+        std::array<OperationMetrics, operationCount> operations;
+
+        const OperationMetrics& operator[](Operation operation) const { return operations[static_cast<std::size_t>(operation)]; }
+        // {"addEdge": {"calls": n, "totalNanos": n, "latencyNanos": {"p50": n, ...}, "work": {"adjacencyScanned": n, ...}}, ...}
+        [[nodiscard]] std::string toJson() const;
+    };
+
+    namespace Detail {
+
+        // Shard counters have a single writer, so a relaxed load and store replaces the locked read-modify-write
+        inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        struct Shard {
+            struct Slot {
+                std::atomic<std::uint64_t> calls{0};
+                std::atomic<std::uint64_t> totalNanos{0};
+                std::array<std::atomic<std::uint64_t>, LatencyHistogram::bucketCount> latency{};
+                std::array<std::atomic<std::uint64_t>, workCount> work{};
+            };
+            std::array<Slot, operationCount> slots{};
+            Operation current = Operation::Other;  // Touched by the owning thread only
+            bool leased = false;                   // Guarded by the registry's lock
+        };
+
+        // Every shard ever handed out. A thread's shard goes back to the pool when the thread exits and the next new
+        // thread keeps adding to it, so the pool is as large as the peak number of recording threads.
+        class Registry {
+        public:
+            static Registry& instance() {
+                static Registry registry;
+                return registry;
+            }
+
+            Shard* lease() {
+                std::lock_guard<std::mutex> guard(lock);
+                for (auto& shard : shards) {
+                    if (!shard->leased) {
+                        shard->leased = true;
+                        return shard.get();
+                    }
+                }
+                shards.push_back(std::unique_ptr<Shard>(new Shard()));
+                shards.back()->leased = true;
+                return shards.back().get();
+            }
+
+            void release(Shard* shard) {
+                std::lock_guard<std::mutex> guard(lock);
+                shard->current = Operation::Other;
+                shard->leased = false;
+            }
+
+            template <typename Visit>
+            void forEach(Visit&& visit) {
+                std::lock_guard<std::mutex> guard(lock);
+                for (auto& shard : shards) {
+                    visit(*shard);
+                }
+            }
+
+        private:
+            std::mutex lock;
+            std::vector<std::unique_ptr<Shard>> shards;
+        };
+
+        struct Lease {
+            Shard* shard = Registry::instance().lease();
+            Lease() = default;
+            Lease(const Lease&) = delete;
+            Lease& operator=(const Lease&) = delete;
+            ~Lease() { Registry::instance().release(shard); }
+        };
+
+        inline Shard& localShard() {
+            thread_local Lease lease;
+            return *lease.shard;
+        }
+
+        template <typename Map, typename = void>
+        struct HasCapacity : std::false_type {};
+
+        template <typename Map>
+        struct HasCapacity<Map, std::void_t<decltype(std::declval<const Map&>().capacity())>> : std::true_type {};
+
+        // Slot count of a hash table, to spot rehashes: FlatHashMap's capacity() or a std map's bucket_count()
+        template <typename Map>
+        std::size_t tableSlots(const Map& map) {
+            if constexpr (HasCapacity<Map>::value) {
+                return map.capacity();
+            } else {
+                return map.bucket_count();
+            }
+        }
+
+    }  // namespace Detail
+
+    // Times one operation on the calling thread and makes it the target of work recorded meanwhile
+    class OperationScope {
+    public:
+        explicit OperationScope(Operation operation)
+                : shard(Detail::localShard()), operation(operation), outer(shard.current), start(std::chrono::steady_clock::now()) {
+            shard.current = operation;
+        }
+        OperationScope(const OperationScope&) = delete;
+        OperationScope& operator=(const OperationScope&) = delete;
+        ~OperationScope() {
+            const auto nanos = static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+            auto& slot = shard.slots[static_cast<std::size_t>(operation)];
+            Detail::bump(slot.calls, 1);
+            Detail::bump(slot.totalNanos, nanos);
+            Detail::bump(slot.latency[LatencyHistogram::bucketOf(nanos)], 1);
+            shard.current = outer;
+        }
+
+    private:
+        Detail::Shard& shard;
+        Operation operation;
+        Operation outer;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    inline void recordWork(Work work, std::uint64_t amount) {
+        Detail::Shard& shard = Detail::localShard();
+        Detail::bump(shard.slots[static_cast<std::size_t>(shard.current)].work[static_cast<std::size_t>(work)], amount);
+    }
+
+    // Sums every shard. Counts recorded while the snapshot is taken may or may not be included.
+    inline Snapshot snapshot();
+    // Zeroes every shard; increments racing with the reset may survive it
+    inline void reset();
+
+    inline std::size_t LatencyHistogram::bucketOf(std::uint64_t value) {
+        if (value < subBuckets) {
+            return static_cast<std::size_t>(value);
+        }
+#if defined(__GNUC__)
+        const unsigned magnitude = 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned magnitude = 0;
+        while ((value >> magnitude) > 1) {
+            ++magnitude;
+        }
+#endif
+        const unsigned shift = magnitude - subBucketBits;
+        return (shift + 1) * subBuckets + static_cast<std::size_t>((value >> shift) - subBuckets);
+    }
+
+    inline std::uint64_t LatencyHistogram::bucketLimit(std::size_t bucket) {
+        if (bucket < subBuckets) {
+            return bucket;
+        }
+        const std::size_t shift = bucket / subBuckets - 1;
+        const std::uint64_t lowest = static_cast<std::uint64_t>(subBuckets + bucket % subBuckets) << shift;
+        return lowest + ((std::uint64_t{1} << shift) - 1);
+    }
+
+    inline void LatencyHistogram::merge(const LatencyHistogram& other) {
+        for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+            counts[bucket] += other.counts[bucket];
+        }
+        total += other.total;
+    }
+
+    inline std::uint64_t LatencyHistogram::percentile(double fraction) const {
+        if (total == 0) {
+            return 0;
+        }
+        const double wanted = fraction * static_cast<double>(total);
+        std::uint64_t rank = static_cast<std::uint64_t>(wanted);
+        if (static_cast<double>(rank) < wanted || rank == 0) {
+            ++rank;
+        }
+        std::uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+            seen += counts[bucket];
+            if (seen >= rank) {
+                return bucketLimit(bucket);
+            }
+        }
+        return bucketLimit(bucketCount - 1);
+    }
+
+    inline std::string Snapshot::toJson() const {
+        std::string json = "{";
+        for (std::size_t index = 0; index < operationCount; ++index) {
+            const OperationMetrics& metrics = operations[index];
+            json += index == 0 ? "\"" : ", \"";
+            json += name(static_cast<Operation>(index));
+            json += "\": {\"calls\": " + std::to_string(metrics.calls) + ", \"totalNanos\": " + std::to_string(metrics.totalNanos);
+            json += ", \"latencyNanos\": {";
+            const std::pair<const char*, double> percentiles[] = {{"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p999", 0.999}, {"max", 1.0}};
+            for (std::size_t rank = 0; rank < std::size(percentiles); ++rank) {
+                json += std::string(rank == 0 ? "\"" : ", \"") + percentiles[rank].first + "\": "
+                        + std::to_string(metrics.latencyNanos.percentile(percentiles[rank].second));
+            }
+            json += "}, \"work\": {";
+            for (std::size_t work = 0; work < workCount; ++work) {
+                json += std::string(work == 0 ? "\"" : ", \"") + name(static_cast<Work>(work)) + "\": " + std::to_string(metrics.work[work]);
+            }
+            json += "}}";
+        }
+        return json + "}";
+    }
+
+    inline Snapshot snapshot() {
+        Snapshot result;
+        Detail::Registry::instance().forEach([&result](const Detail::Shard& shard) {
+            for (std::size_t index = 0; index < operationCount; ++index) {
+                const auto& slot = shard.slots[index];
+                OperationMetrics& metrics = result.operations[index];
+                metrics.calls += slot.calls.load(std::memory_order_relaxed);
+                metrics.totalNanos += slot.totalNanos.load(std::memory_order_relaxed);
+                for (std::size_t bucket = 0; bucket < LatencyHistogram::bucketCount; ++bucket) {
+                    const std::uint64_t count = slot.latency[bucket].load(std::memory_order_relaxed);
+                    if (count != 0) {
+                        metrics.latencyNanos.add(bucket, count);
+                    }
+                }
+                for (std::size_t work = 0; work < workCount; ++work) {
+                    metrics.work[work] += slot.work[work].load(std::memory_order_relaxed);
+                }
+            }
+        });
+        return result;
+    }
+
+    inline void reset() {
+        Detail::Registry::instance().forEach([](Detail::Shard& shard) {
+            for (auto& slot : shard.slots) {
+                slot.calls.store(0, std::memory_order_relaxed);
+                slot.totalNanos.store(0, std::memory_order_relaxed);
+                for (auto& count : slot.latency) {
+                    count.store(0, std::memory_order_relaxed);
+                }
+                for (auto& count : slot.work) {
+                    count.store(0, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+}  // namespace GraphMetrics
+#endif
@@ -0,0 +1,91 @@
+// Created by Aaron H on 5/28/24.
+#ifndef GRAPHSTATS_HPP
+#define GRAPHSTATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// Snapshot of the counters a graph keeps up to date on every mutation
+struct GraphStats {
+    std::size_t numVertices = 0;
+    std::size_t numEdges = 0;
+    std::size_t maxOutDegree = 0;
+    // Edges whose weight compares below zero; always 0 for non-arithmetic weight types
+    std::size_t negativeWeightEdges = 0;
+    // Bucket 0 counts vertices without out-edges, bucket b > 0 counts out-degrees in [2^(b-1), 2^b)
+    std::array<std::size_t, 65> outDegreeHistogram{};
+};
+
+// Weights that are not arithmetic have no sign and never count as negative
+template<typename EdgeType>
+bool isNegativeWeight(const EdgeType& weight) {
+    if constexpr (std::is_arithmetic<EdgeType>::value) {
+        return weight < EdgeType(0);
+    } else {
+        return false;
+    }
+}
+
+// Running vertex, edge, out-degree and negative-weight counters. Callers report every change so stats() stays O(1).
+class DegreeCounters {
+public:
+    void vertexAdded(std::size_t degree = 0) {
+        ++current.numVertices;
+        current.numEdges += degree;
+        track(degree, true);
+    }
+
+    void vertexRemoved(std::size_t degree) {
+        --current.numVertices;
+        current.numEdges -= degree;
+        track(degree, false);
+    }
+
+    void degreeChanged(std::size_t oldDegree, std::size_t newDegree) {
+        current.numEdges += newDegree;
+        current.numEdges -= oldDegree;
+        track(oldDegree, false);
+        track(newDegree, true);
+    }
+
+    void negativeWeightAdded(std::size_t count = 1) { current.negativeWeightEdges += count; }
+    void negativeWeightRemoved(std::size_t count = 1) { current.negativeWeightEdges -= count; }
+
+    [[nodiscard]] std::size_t numEdges() const { return current.numEdges; }
+    [[nodiscard]] const GraphStats& stats() const { return current; }
+
+    static std::size_t bucketOf(std::size_t degree) {
+        std::size_t bucket = 0;
+        for (; degree != 0; degree >>= 1) {
+            ++bucket;
+        }
+        return bucket;
+    }
+
+private:
+    void track(std::size_t degree, bool added) {
+        if (added) {
+            if (degree >= verticesWithDegree.size()) {
+                verticesWithDegree.resize(degree + 1, 0);
+            }
+            ++verticesWithDegree[degree];
+            ++current.outDegreeHistogram[bucketOf(degree)];
+            if (degree > current.maxOutDegree) {
+                current.maxOutDegree = degree;
+            }
+            return;
+        }
+        --verticesWithDegree[degree];
+        --current.outDegreeHistogram[bucketOf(degree)];
+        while (current.maxOutDegree > 0 && verticesWithDegree[current.maxOutDegree] == 0) {
+            --current.maxOutDegree;
+        }
+    }
+
+    GraphStats current;
+    // Exact degree frequencies so the maximum can step down when its last vertex loses an edge
+    std::vector<std::size_t> verticesWithDegree;
+};
+#endif
@@ -0,0 +1,73 @@
+// Created by Aaron H on 5/28/24.
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Read-only memory mapping of a whole file, unmapped on destruction. An empty file maps to no memory at all.
+class MappedFile {
+public:
+    enum AccessPattern { Normal, Sequential, Random };
+
+    explicit MappedFile(const std::string& path, AccessPattern pattern = Normal) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open file: " + path);
+        }
+        struct stat status{};
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat file: " + path);
+        }
+        length = static_cast<std::size_t>(status.st_size);
+        if (length > 0) {
+            void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map file: " + path);
+            }
+            bytes = static_cast<const char*>(mapping);
+            if (pattern != Normal) {
+                // Only a hint to the kernel's readahead; failure is harmless
+                ::madvise(mapping, length, pattern == Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+            }
+        }
+        ::close(fd);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept
+            : bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)) {}
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            bytes = std::exchange(other.bytes, nullptr);
+            length = std::exchange(other.length, 0);
+        }
+        return *this;
+    }
+    ~MappedFile() { unmap(); }
+
+    [[nodiscard]] const char* data() const { return bytes; }
+    [[nodiscard]] std::size_t size() const { return length; }
+
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+
+    void unmap() {
+        if (bytes != nullptr) {
+            ::munmap(const_cast<char*>(bytes), length);
+            bytes = nullptr;
+        }
+    }
+};
+#endif
@@ -0,0 +1,91 @@
+// Created by Aaron H on 5/28/24.
+#ifndef VERTEXINTERNER_HPP
+#define VERTEXINTERNER_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+#include "GraphMetrics.hpp"
+#include "../../Data-Structures/Hash-Tables/FlatHashMap.hpp"
+
+// Assigns every vertex a dense 32-bit id once so graph internals and algorithms work on integers instead of
+// hashing and copying VerticeType. Ids of removed vertices are recycled, so ids stay below bound().
+// All storage comes from one memory resource, the default one unless a resource is passed in. The vertex-to-id map
+// is a template parameter; any map with find/emplace/erase/reserve and a memory-resource constructor will do, e.g.
+// std::pmr::unordered_map<VerticeType, std::uint32_t>.
+template<typename VerticeType, typename IdMap = PmrFlatHashMap<VerticeType, std::uint32_t>>
+class VertexInterner {
+public:
+    using VertexId = std::uint32_t;
+    static constexpr VertexId npos = std::numeric_limits<VertexId>::max();
+
+    VertexInterner() = default;
+    explicit VertexInterner(std::pmr::memory_resource* resource) : ids(resource), values(resource), live(resource), freeIds(resource) {}
+
+    // Returns the vertex's id and whether it was newly interned
+    std::pair<VertexId, bool> insert(const VerticeType &vertex);
+    [[nodiscard]] VertexId find(const VerticeType &vertex) const;
+    void erase(VertexId id);
+    void reserve(std::size_t count);
+
+    const VerticeType& value(VertexId id) const { return values[id]; }
+    [[nodiscard]] bool contains(VertexId id) const { return id < live.size() && live[id]; }
+    [[nodiscard]] std::size_t size() const { return ids.size(); }
+    [[nodiscard]] VertexId bound() const { return static_cast<VertexId>(values.size()); }
+
+private:
+    IdMap ids;
+    std::pmr::vector<VerticeType> values;
+    std::pmr::vector<bool> live;
+    std::pmr::vector<VertexId> freeIds;
+};
+
+template<typename VerticeType, typename IdMap>
+std::pair<typename VertexInterner<VerticeType, IdMap>::VertexId, bool> VertexInterner<VerticeType, IdMap>::insert(const VerticeType &vertex) {
+    // One probe both looks the vertex up and claims its slot
+    const VertexId id = freeIds.empty() ? static_cast<VertexId>(values.size()) : freeIds.back();
+#if defined(GRAPH_INSTRUMENTATION)
+    const std::size_t slotsBefore = GraphMetrics::Detail::tableSlots(ids);
+#endif
+    auto inserted = ids.try_emplace(vertex, id);
+    GRAPH_METRICS_WORK(Rehashes, GraphMetrics::Detail::tableSlots(ids) != slotsBefore);
+    if (!inserted.second) {
+        return {inserted.first->second, false};
+    }
+    if (id == npos) {
+        ids.erase(vertex);
+        throw std::runtime_error("Vertex id space exhausted");
+    }
+    if (!freeIds.empty()) {
+        freeIds.pop_back();
+        values[id] = vertex;
+        live[id] = true;
+    } else {
+        values.push_back(vertex);
+        live.push_back(true);
+    }
+    return {id, true};
+}
+
+template<typename VerticeType, typename IdMap>
+typename VertexInterner<VerticeType, IdMap>::VertexId VertexInterner<VerticeType, IdMap>::find(const VerticeType &vertex) const {
+    auto it = ids.find(vertex);
+    return it == ids.end() ? npos : it->second;
+}
+
+template<typename VerticeType, typename IdMap>
+void VertexInterner<VerticeType, IdMap>::erase(VertexId id) {
+    ids.erase(values[id]);
+    live[id] = false;
+    freeIds.push_back(id);
+}
+
+template<typename VerticeType, typename IdMap>
+void VertexInterner<VerticeType, IdMap>::reserve(std::size_t count) {
+    ids.reserve(count);
+    values.reserve(count);
+    live.reserve(count);
+}
+#endif
@@ -0,0 +1,621 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Data-Structures/Hash-Tables/FlatHashMap.hpp"
+#include "../Structures/ADT/EdgeListReader.hpp"
+#include "../Structures/ADT/GraphFile.hpp"
+#include "../Structures/ADT/ConcurrentGraph.hpp"
+#include "../Algorithms/Searching/DFS/DFS.hpp"
+#include "../Algorithms/GraphAlgorithms/ShortestPaths.hpp"
+#include "../Algorithms/GraphAlgorithms/DeltaStepping.hpp"
+#include "../Algorithms/GraphAlgorithms/TopologicalSort.hpp"
+#include "../Algorithms/GraphAlgorithms/Triangles.hpp"
+#include "../Algorithms/GraphAlgorithms/PageRank.hpp"
+#include "../Algorithms/Sorting/PdqSort.hpp"
+#include "../Algorithms/Sorting/RadixSort.hpp"
+#include "../Algorithms/Sorting/SampleSort.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory_resource>
+#include <random>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    enum Shape { Path, Random, PowerLaw, Dense };
+
+    // Every shape is oriented from lower to higher vertex so the same edges load into a DAG
+    std::vector<std::tuple<int, int, int>> makeEdges(Shape shape, int vertices) {
+        std::mt19937 rng(42);
+        std::vector<std::tuple<int, int, int>> edges;
+        auto addOriented = [&](int a, int b) {
+            if (a != b) edges.emplace_back(std::min(a, b), std::max(a, b), 1);
+        };
+        switch (shape) {
+            case Path:
+                for (int i = 0; i + 1 < vertices; i++) addOriented(i, i + 1);
+                break;
+            case Random: {
+                std::uniform_int_distribution<int> pick(0, vertices - 1);
+                for (int i = 0; i < 8 * vertices; i++) addOriented(pick(rng), pick(rng));
+                break;
+            }
+            case PowerLaw: {
+                // Preferential attachment: each new vertex links to endpoints of earlier edges
+                std::vector<int> endpoints{0};
+                for (int i = 1; i < vertices; i++) {
+                    for (int k = 0; k < 4; k++) {
+                        int target = endpoints[rng() % endpoints.size()];
+                        addOriented(target, i);
+                        endpoints.push_back(target);
+                    }
+                    endpoints.push_back(i);
+                }
+                break;
+            }
+            case Dense: {
+                std::bernoulli_distribution keep(0.25);
+                for (int i = 0; i < vertices; i++)
+                    for (int j = i + 1; j < vertices; j++)
+                        if (keep(rng)) edges.emplace_back(i, j, 1);
+                break;
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end(), [](const auto& a, const auto& b) {
+            return std::get<0>(a) == std::get<0>(b) && std::get<1>(a) == std::get<1>(b);
+        }), edges.end());
+        std::shuffle(edges.begin(), edges.end(), rng);
+        return edges;
+    }
+
+    DerivedGraph<int, int> emptyGraph(int vertices) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 0; i < vertices; i++) graph.addVertex(i);
+        return graph;
+    }
+
+    void shapeArguments(benchmark::internal::Benchmark* bench) {
+        bench->ArgNames({"shape", "vertices"});
+        for (int shape : {Path, Random, PowerLaw}) {
+            for (int vertices : {1 << 10, 1 << 14, 1 << 17}) bench->Args({shape, vertices});
+        }
+        for (int vertices : {1 << 8, 1 << 10}) bench->Args({Dense, vertices});
+    }
+
+    void setEdgeCounters(benchmark::State& state, std::size_t edges) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * edges));
+        state.counters["edges"] = static_cast<double>(edges);
+    }
+
+    void BM_AddVertex(benchmark::State& state) {
+        for (auto _ : state) {
+            DerivedGraph<int, int> graph(DAG);
+            for (int i = 0; i < state.range(0); i++) graph.addVertex(i);
+            benchmark::DoNotOptimize(graph);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_AddVertex)->RangeMultiplier(8)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMillisecond);
+
+    template <bool CheckForCycle>
+    void BM_AddEdge(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1)));
+        for (auto _ : state) {
+            state.PauseTiming();
+            DerivedGraph<int, int> graph = emptyGraph(static_cast<int>(state.range(1)));
+            state.ResumeTiming();
+            for (const auto& edge : edges) graph.addEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge), CheckForCycle);
+            benchmark::DoNotOptimize(graph);
+        }
+        setEdgeCounters(state, edges.size());
+    }
+    BENCHMARK_TEMPLATE(BM_AddEdge, true)->Apply(shapeArguments)->Unit(benchmark::kMillisecond);
+    BENCHMARK_TEMPLATE(BM_AddEdge, false)->Apply(shapeArguments)->Unit(benchmark::kMillisecond);
+
+    // BM_AddEdge<false> with the graph type fixed by a static policy instead of checked at run time
+    void BM_AddEdgeStaticPolicy(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1)));
+        for (auto _ : state) {
+            state.PauseTiming();
+            DagGraph<int, int> graph;
+            for (int i = 0; i < state.range(1); i++) graph.addVertex(i);
+            state.ResumeTiming();
+            for (const auto& edge : edges) graph.addEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge), false);
+            benchmark::DoNotOptimize(graph);
+        }
+        setEdgeCounters(state, edges.size());
+    }
+    BENCHMARK(BM_AddEdgeStaticPolicy)->Apply(shapeArguments)->Unit(benchmark::kMillisecond);
+
+    // The same inserts as BM_AddEdge committed as one batch. Against vertices added in reverse every edge opposes
+    // the current order, so the commit takes the full Kahn pass instead of extending the order.
+    template <bool AlongOrder>
+    void BM_BatchAddEdge(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1)));
+        for (auto _ : state) {
+            state.PauseTiming();
+            DerivedGraph<int, int> graph(DAG);
+            for (int i = 0; i < state.range(1); i++) graph.addVertex(AlongOrder ? i : static_cast<int>(state.range(1)) - 1 - i);
+            state.ResumeTiming();
+            auto batch = graph.batch();
+            for (const auto& edge : edges) batch.addEdge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
+            batch.commit();
+            benchmark::DoNotOptimize(graph);
+        }
+        setEdgeCounters(state, edges.size());
+    }
+    BENCHMARK_TEMPLATE(BM_BatchAddEdge, true)->Apply(shapeArguments)->Unit(benchmark::kMillisecond);
+    BENCHMARK_TEMPLATE(BM_BatchAddEdge, false)->Apply(shapeArguments)->Unit(benchmark::kMillisecond);
+
+    void BM_FromEdges(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(DerivedGraph<int, int>::from_edges(edges, DAG));
+        }
+        setEdgeCounters(state, edges.size());
+    }
+    BENCHMARK(BM_FromEdges)->Apply(shapeArguments)->Unit(benchmark::kMillisecond);
+
+    enum Resource { DefaultHeap, Monotonic, Pool };
+
+    // Counts the blocks and bytes an allocation strategy takes from the system, as a proxy for RSS
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations = 0;
+        std::size_t liveBytes = 0;
+        std::size_t peakBytes = 0;
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            liveBytes += bytes;
+            peakBytes = std::max(peakBytes, liveBytes);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+            liveBytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    // Construction plus teardown of a whole graph, per memory resource
+    void BM_FromEdgesWithResource(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(1)), static_cast<int>(state.range(2)));
+        CountingResource upstream;
+        for (auto _ : state) {
+            std::pmr::monotonic_buffer_resource monotonic(&upstream);
+            std::pmr::unsynchronized_pool_resource pool(&upstream);
+            std::pmr::memory_resource* resource = &upstream;
+            if (state.range(0) == Monotonic) resource = &monotonic;
+            if (state.range(0) == Pool) resource = &pool;
+            benchmark::DoNotOptimize(DerivedGraph<int, int>::from_edges(edges, DAG, resource));
+        }
+        setEdgeCounters(state, edges.size());
+        state.counters["allocations"] = benchmark::Counter(static_cast<double>(upstream.allocations), benchmark::Counter::kAvgIterations);
+        state.counters["peak_bytes"] = static_cast<double>(upstream.peakBytes);
+    }
+    BENCHMARK(BM_FromEdgesWithResource)->ArgNames({"resource", "shape", "vertices"})
+            ->ArgsProduct({{DefaultHeap, Monotonic, Pool}, {Path, PowerLaw}, {1 << 14, 1 << 20}})->Unit(benchmark::kMillisecond);
+
+    void BM_RemoveVertex(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1)));
+        std::size_t removals = 0;
+        for (auto _ : state) {
+            state.PauseTiming();
+            DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(edges, DAG);
+            std::vector<int> victims;
+            for (std::uint32_t id = 0; id < graph.idBound(); id += 4) victims.push_back(graph.vertexOf(id));
+            removals = victims.size();
+            state.ResumeTiming();
+            for (int vertex : victims) graph.removeVertex(vertex);
+            benchmark::DoNotOptimize(graph);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * removals));
+    }
+    BENCHMARK(BM_RemoveVertex)->Apply(shapeArguments)->Unit(benchmark::kMillisecond);
+
+    void BM_HasEdge(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1)));
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(edges, DAG);
+        std::size_t next = 0;
+        for (auto _ : state) {
+            // Alternate hits and (mostly) misses
+            const auto& edge = edges[next++ % edges.size()];
+            benchmark::DoNotOptimize(graph.hasEdge(std::get<0>(edge), std::get<1>(edge)));
+            benchmark::DoNotOptimize(graph.hasEdge(std::get<1>(edge), std::get<0>(edge)));
+        }
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+    BENCHMARK(BM_HasEdge)->Apply(shapeArguments);
+
+    // Point lookups, half hits and half misses, with keys spread like vertex ids
+    template <typename Map>
+    void BM_HashLookup(benchmark::State& state) {
+        const auto size = static_cast<int>(state.range(0));
+        std::mt19937 rng(5);
+        Map map;
+        for (int i = 0; i < size; i++) map.emplace(static_cast<int>(rng() >> 1), i);
+        std::vector<int> probes(4096);
+        for (auto& probe : probes) probe = static_cast<int>(rng() >> 1);
+        std::size_t next = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(map.find(probes[next++ & 4095]) != map.end());
+        }
+    }
+    BENCHMARK_TEMPLATE(BM_HashLookup, FlatHashMap<int, int>)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+    BENCHMARK_TEMPLATE(BM_HashLookup, std::unordered_map<int, int>)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+
+    void BM_NumEdges(benchmark::State& state) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(makeEdges(Random, static_cast<int>(state.range(0))), DAG);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(graph.numEdges());
+        }
+    }
+    BENCHMARK(BM_NumEdges)->RangeMultiplier(8)->Range(1 << 10, 1 << 17);
+
+    void BM_IsCyclic(benchmark::State& state) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(
+                makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GraphAlgorithms::isCyclic(graph));
+        }
+        setEdgeCounters(state, graph.numEdges());
+    }
+    BENCHMARK(BM_IsCyclic)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+
+    void BM_DFS(benchmark::State& state) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(
+                makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Searching::DFS(graph, graph.vertexOf(0)));
+        }
+        setEdgeCounters(state, graph.numEdges());
+    }
+    BENCHMARK(BM_DFS)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+
+    void BM_DFSFrozen(benchmark::State& state) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(
+                makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG);
+        CSRGraph<int, int> frozen = graph.freeze();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Searching::DFS(frozen, frozen.vertexOf(0)));
+        }
+        setEdgeCounters(state, frozen.numEdges());
+    }
+    BENCHMARK(BM_DFSFrozen)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+
+    // Same shapes with weights drawn from [1, 1000] and every edge stored both ways, so one component spans the graph
+    CSRGraph<int, int> weightedGraph(benchmark::State& state) {
+        auto edges = makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1)));
+        std::mt19937 rng(7);
+        const std::size_t count = edges.size();
+        for (std::size_t i = 0; i < count; i++) {
+            int weight = 1 + static_cast<int>(rng() % 1000);
+            std::get<2>(edges[i]) = weight;
+            edges.emplace_back(std::get<1>(edges[i]), std::get<0>(edges[i]), weight);
+        }
+        return DerivedGraph<int, int>::from_edges(edges, UDG).freeze();
+    }
+
+    template <template <typename> class Heap>
+    void BM_Dijkstra(benchmark::State& state) {
+        CSRGraph<int, int> graph = weightedGraph(state);
+        GraphAlgorithms::DijkstraEngine<CSRGraph<int, int>, Heap> engine(graph);
+        for (auto _ : state) {
+            engine.run(graph.idOf(0));
+            benchmark::DoNotOptimize(engine.distance(graph.idBound() - 1));
+        }
+        setEdgeCounters(state, graph.numEdges());
+    }
+    BENCHMARK_TEMPLATE(BM_Dijkstra, DaryHeap)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK_TEMPLATE(BM_Dijkstra, PairingHeap)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK_TEMPLATE(BM_Dijkstra, RadixHeap)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+
+    // Random point-to-point queries on one engine, the routing workload: early exit plus reset of touched state only
+    template <template <typename> class Heap>
+    void BM_DijkstraQuery(benchmark::State& state) {
+        CSRGraph<int, int> graph = weightedGraph(state);
+        GraphAlgorithms::DijkstraEngine<CSRGraph<int, int>, Heap> engine(graph);
+        std::mt19937 rng(3);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(engine.run(rng() % graph.idBound(), rng() % graph.idBound()));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_TEMPLATE(BM_DijkstraQuery, DaryHeap)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK_TEMPLATE(BM_DijkstraQuery, RadixHeap)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+
+    // Compare with BM_Dijkstra on the same shapes; the sequential baseline is the threads:1 row
+    void BM_DeltaStepping(benchmark::State& state) {
+        CSRGraph<int, int> graph = weightedGraph(state);
+        GraphAlgorithms::DeltaSteppingOptions options;
+        options.threads = static_cast<unsigned>(state.range(2));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GraphAlgorithms::deltaStepping(graph, 0, options));
+        }
+        setEdgeCounters(state, graph.numEdges());
+    }
+    BENCHMARK(BM_DeltaStepping)->ArgNames({"shape", "vertices", "threads"})
+            ->ArgsProduct({{Random, PowerLaw}, {1 << 14, 1 << 17, 1 << 20}, {1, 2, 4, 8}})
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    template <GraphAlgorithms::TopologicalMethod Method>
+    void BM_TopologicalSort(benchmark::State& state) {
+        CSRGraph<int, int> graph = DerivedGraph<int, int>::from_edges(
+                makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG).freeze();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GraphAlgorithms::topologicalOrderIds(graph, Method));
+        }
+        setEdgeCounters(state, graph.numEdges());
+    }
+    BENCHMARK_TEMPLATE(BM_TopologicalSort, GraphAlgorithms::TopologicalMethod::Kahn)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+    BENCHMARK_TEMPLATE(BM_TopologicalSort, GraphAlgorithms::TopologicalMethod::DepthFirst)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+
+    // Reports the level count too: vertices / levels is the average parallelism a scheduler could extract
+    void BM_Levelize(benchmark::State& state) {
+        CSRGraph<int, int> graph = DerivedGraph<int, int>::from_edges(
+                makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG).freeze();
+        std::size_t levels = 0;
+        for (auto _ : state) {
+            levels = GraphAlgorithms::levelize(graph, static_cast<unsigned>(state.range(2))).numLevels();
+        }
+        setEdgeCounters(state, graph.numEdges());
+        state.counters["levels"] = static_cast<double>(levels);
+    }
+    BENCHMARK(BM_Levelize)->ArgNames({"shape", "vertices", "threads"})
+            ->ArgsProduct({{Random, PowerLaw}, {1 << 14, 1 << 17}, {1, 2, 4, 8}})
+            ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Many short searches on one engine, resetting in between: what the color map's reset costs
+    template <typename ColorMap>
+    void BM_DFSRepeated(benchmark::State& state) {
+        CSRGraph<int, int> graph = DerivedGraph<int, int>::from_edges(
+                makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG).freeze();
+        Searching::DFSEngine<CSRGraph<int, int>, ColorMap> engine(graph);
+        Searching::DFSVisitor visitor;
+        std::mt19937 rng(1);
+        for (auto _ : state) {
+            engine.visit(rng() % graph.idBound(), visitor);
+            engine.reset();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK_TEMPLATE(BM_DFSRepeated, Searching::PackedColorMap)->Apply(shapeArguments);
+    BENCHMARK_TEMPLATE(BM_DFSRepeated, Searching::EpochColorMap)->Apply(shapeArguments);
+
+    // Read scaling across request threads: hasEdge probes through a pinned snapshot per request, against the same
+    // probes on a DerivedGraph behind a reader-writer lock. Per-thread rates should stay flat for the snapshot reads.
+    ConcurrentGraph<int, int>& sharedSnapshotGraph() {
+        static ConcurrentGraph<int, int> graph(DAG, 16);
+        static const bool loaded = [] {
+            graph.staging() = DerivedGraph<int, int>::from_edges(makeEdges(PowerLaw, 1 << 17), DAG);
+            graph.publish();
+            return true;
+        }();
+        (void) loaded;
+        return graph;
+    }
+
+    void BM_SnapshotReads(benchmark::State& state) {
+        ConcurrentGraph<int, int>& graph = sharedSnapshotGraph();
+        auto reader = graph.reader();
+        std::mt19937 rng(state.thread_index());
+        for (auto _ : state) {
+            auto snapshot = reader.pin();
+            const int source = static_cast<int>(rng() % (1 << 17));
+            benchmark::DoNotOptimize(snapshot->hasEdge(source, source + 1));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_SnapshotReads)->ThreadRange(1, 8)->UseRealTime();
+
+    void BM_LockedReads(benchmark::State& state) {
+        static const DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(makeEdges(PowerLaw, 1 << 17), DAG);
+        static std::shared_mutex lock;
+        std::mt19937 rng(state.thread_index());
+        for (auto _ : state) {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            const int source = static_cast<int>(rng() % (1 << 17));
+            benchmark::DoNotOptimize(graph.hasEdge(source, source + 1));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_LockedReads)->ThreadRange(1, 8)->UseRealTime();
+
+    // Startup cost of a mapped graph file, to set against BM_FromEdges; touches every row so pages are faulted in
+    void BM_MapGraphFile(benchmark::State& state) {
+        const std::string path = "graph_benchmark.uag";
+        writeGraphFile(DerivedGraph<int, int>::from_edges(
+                makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG), path);
+        std::size_t edges = 0;
+        for (auto _ : state) {
+            MappedCSRGraph<int, int> mapped(path);
+            std::size_t touched = 0;
+            for (std::uint32_t id = 0; id < mapped.idBound(); id++) touched += mapped.outDegree(id);
+            benchmark::DoNotOptimize(touched);
+            edges = mapped.numEdges();
+        }
+        setEdgeCounters(state, edges);
+        std::remove(path.c_str());
+    }
+    BENCHMARK(BM_MapGraphFile)->Apply(shapeArguments)->Unit(benchmark::kMicrosecond);
+
+    // Text ingest throughput in bytes per second, across parser threads
+    void BM_ReadEdgeList(benchmark::State& state) {
+        const std::string path = "edge_list_benchmark.txt";
+        {
+            std::ofstream out(path);
+            out << "# FromNodeId\tToNodeId\tWeight\n";
+            for (const auto& edge : makeEdges(PowerLaw, 1 << 18)) {
+                out << std::get<0>(edge) << '\t' << std::get<1>(edge) << '\t' << std::get<2>(edge) << '\n';
+            }
+        }
+        EdgeListOptions options;
+        options.threads = static_cast<unsigned>(state.range(0));
+        options.chunkBytes = std::size_t{1} << 20;  // The file is small, keep enough chunks for every thread
+        for (auto _ : state) {
+            auto edges = readEdgeList<int, int>(path, options);
+            benchmark::DoNotOptimize(edges.data());
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * MappedFile(path).size()));
+        std::remove(path.c_str());
+    }
+    BENCHMARK(BM_ReadEdgeList)->ArgName("threads")->RangeMultiplier(2)->Range(1, 8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Edge-record sorts as a CSR build does them: (source, destination, weight) ordered by (source, destination)
+    struct EdgeRecord {
+        std::uint32_t source;
+        std::uint32_t destination;
+        int weight;
+    };
+
+    std::uint64_t edgeRecordKey(const EdgeRecord& record) {
+        return static_cast<std::uint64_t>(record.source) << 32 | record.destination;
+    }
+
+    enum SortInput { RandomRecords, SortedRecords, ReversedRecords, DuplicateRecords };
+
+    std::vector<EdgeRecord> makeRecords(SortInput input, std::size_t size) {
+        std::mt19937 rng(42);
+        // Random endpoints over size / 8 vertices, or 16 distinct edges for the duplicate-heavy input
+        const std::uint32_t vertices = input == DuplicateRecords ? 4 : static_cast<std::uint32_t>(std::max<std::size_t>(size / 8, 2));
+        std::vector<EdgeRecord> records(size);
+        for (auto& record : records) record = {static_cast<std::uint32_t>(rng() % vertices), static_cast<std::uint32_t>(rng() % vertices), 1};
+        auto byKey = [](const EdgeRecord& a, const EdgeRecord& b) { return edgeRecordKey(a) < edgeRecordKey(b); };
+        if (input == SortedRecords) std::sort(records.begin(), records.end(), byKey);
+        if (input == ReversedRecords) std::sort(records.rbegin(), records.rend(), byKey);
+        return records;
+    }
+
+    enum class SortMethod { Std, StdStable, Pdq, Radix, InPlaceRadix, Sample };
+
+    template <SortMethod Method>
+    void BM_SortEdgeRecords(benchmark::State& state) {
+        const auto input = makeRecords(static_cast<SortInput>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+        auto byKey = [](const EdgeRecord& a, const EdgeRecord& b) { return edgeRecordKey(a) < edgeRecordKey(b); };
+        std::vector<EdgeRecord> records;
+        for (auto _ : state) {
+            state.PauseTiming();
+            records = input;
+            state.ResumeTiming();
+            switch (Method) {
+                case SortMethod::Std: std::sort(records.begin(), records.end(), byKey); break;
+                case SortMethod::StdStable: std::stable_sort(records.begin(), records.end(), byKey); break;
+                case SortMethod::Pdq: Sorting::pdqsort(records.begin(), records.end(), byKey); break;
+                case SortMethod::Radix: Sorting::radixSort(records.begin(), records.end(), edgeRecordKey); break;
+                case SortMethod::InPlaceRadix: Sorting::inPlaceRadixSort(records.begin(), records.end(), edgeRecordKey); break;
+                case SortMethod::Sample: Sorting::sampleSort(records.begin(), records.end(), byKey); break;
+            }
+            benchmark::DoNotOptimize(records.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+    }
+
+    void sortArguments(benchmark::internal::Benchmark* bench) {
+        bench->ArgNames({"input", "records"});
+        for (int input : {RandomRecords, SortedRecords, ReversedRecords, DuplicateRecords}) {
+            for (int records : {1 << 14, 1 << 18, 1 << 22}) bench->Args({input, records});
+        }
+    }
+    BENCHMARK_TEMPLATE(BM_SortEdgeRecords, SortMethod::Std)->Apply(sortArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK_TEMPLATE(BM_SortEdgeRecords, SortMethod::StdStable)->Apply(sortArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK_TEMPLATE(BM_SortEdgeRecords, SortMethod::Pdq)->Apply(sortArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK_TEMPLATE(BM_SortEdgeRecords, SortMethod::Radix)->Apply(sortArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK_TEMPLATE(BM_SortEdgeRecords, SortMethod::InPlaceRadix)->Apply(sortArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK_TEMPLATE(BM_SortEdgeRecords, SortMethod::Sample)->Apply(sortArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Sorted-set intersection kernels on two random lists of the given length drawn from 4x as many ids
+    enum class IntersectKernel { Scalar, Gallop, Best };
+
+    template <IntersectKernel Kernel>
+    void BM_IntersectSorted(benchmark::State& state) {
+        std::mt19937 rng(42);
+        const auto size = static_cast<std::size_t>(state.range(0));
+        auto makeList = [&] {
+            std::vector<std::uint32_t> list(size);
+            for (auto& id : list) id = static_cast<std::uint32_t>(rng() % (4 * size));
+            std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+            return list;
+        };
+        const auto a = makeList();
+        const auto b = makeList();
+        auto none = [](std::uint32_t) {};
+        for (auto _ : state) {
+            std::size_t common = 0;
+            switch (Kernel) {
+                case IntersectKernel::Scalar:
+                    common = GraphAlgorithms::IntersectionDetail::scalarIntersect(a.data(), a.size(), b.data(), b.size(), none);
+                    break;
+                case IntersectKernel::Gallop:
+                    common = GraphAlgorithms::IntersectionDetail::gallopIntersect(a.data(), a.size(), b.data(), b.size(), none);
+                    break;
+                case IntersectKernel::Best:
+                    common = GraphAlgorithms::intersectionSize(a.data(), a.size(), b.data(), b.size());
+                    break;
+            }
+            benchmark::DoNotOptimize(common);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (a.size() + b.size())));
+    }
+    BENCHMARK_TEMPLATE(BM_IntersectSorted, IntersectKernel::Scalar)->RangeMultiplier(8)->Range(16, 1 << 16);
+    BENCHMARK_TEMPLATE(BM_IntersectSorted, IntersectKernel::Gallop)->RangeMultiplier(8)->Range(16, 1 << 16);
+    BENCHMARK_TEMPLATE(BM_IntersectSorted, IntersectKernel::Best)->RangeMultiplier(8)->Range(16, 1 << 16);
+
+    void triangleArguments(benchmark::internal::Benchmark* bench) {
+        bench->ArgNames({"shape", "vertices", "threads"});
+        for (int shape : {Random, PowerLaw}) bench->Args({shape, 1 << 17, 1})->Args({shape, 1 << 17, 4});
+        bench->Args({Dense, 1 << 10, 1})->Args({Dense, 1 << 10, 4});
+    }
+
+    DerivedGraph<int, int> undirectedGraph(const benchmark::State& state) {
+        return DerivedGraph<int, int>::from_edges(makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), UDG);
+    }
+
+    // Triangle counting alone, on a view built once
+    void BM_CountTriangles(benchmark::State& state) {
+        const auto view = GraphAlgorithms::degreeOrderedView(undirectedGraph(state));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(GraphAlgorithms::countTriangles(view, static_cast<unsigned>(state.range(2))));
+        }
+        setEdgeCounters(state, view.numEdges());
+    }
+    BENCHMARK(BM_CountTriangles)->Apply(triangleArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Local clustering coefficients end to end, view construction included
+    void BM_ClusteringCoefficients(benchmark::State& state) {
+        const auto graph = undirectedGraph(state);
+        for (auto _ : state) {
+            auto coefficients = GraphAlgorithms::clusteringCoefficients(graph, static_cast<unsigned>(state.range(2)));
+            benchmark::DoNotOptimize(coefficients.data());
+        }
+        setEdgeCounters(state, graph.numEdges());
+    }
+    BENCHMARK(BM_ClusteringCoefficients)->Apply(triangleArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    // Fixed number of pull sweeps over a frozen graph with in-edges, float against double scores
+    template <typename Scalar>
+    void BM_PageRank(benchmark::State& state) {
+        const auto frozen = DerivedGraph<int, int>::from_edges(makeEdges(static_cast<Shape>(state.range(0)), static_cast<int>(state.range(1))), DAG).freeze(true);
+        GraphAlgorithms::PageRankOptions options;
+        options.tolerance = 0.0;
+        options.maxIterations = 10;
+        options.threads = static_cast<unsigned>(state.range(2));
+        for (auto _ : state) {
+            auto result = GraphAlgorithms::pageRank<Scalar>(frozen, options);
+            benchmark::DoNotOptimize(result.scores.data());
+        }
+        setEdgeCounters(state, frozen.numEdges());
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * frozen.numEdges() * options.maxIterations));
+    }
+    BENCHMARK_TEMPLATE(BM_PageRank, float)->Apply(triangleArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+    BENCHMARK_TEMPLATE(BM_PageRank, double)->Apply(triangleArguments)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/Searching/BFS/BFS.hpp"
+#include <gtest/gtest.h>
+#include <queue>
+#include <random>
+namespace {
+
+    CSRGraph<int, int> randomGraph(int vertices, int edges, bool withInEdges) {
+        std::mt19937 rng(7);
+        DerivedGraph<int, int> graph(UDG);
+        for (int i = 0; i < vertices; i++) graph.addVertex(i);
+        for (int i = 0; i < edges; i++) {
+            int source = rng() % vertices, destination = rng() % vertices;
+            if (!graph.hasEdge(source, destination)) graph.addEdge(source, destination, 1, false);
+        }
+        return graph.freeze(withInEdges);
+    }
+
+    std::vector<std::uint32_t> referenceDepths(const CSRGraph<int, int>& graph, std::uint32_t source) {
+        std::vector<std::uint32_t> depth(graph.numVertices(), Searching::BFSResult::unreached);
+        std::queue<std::uint32_t> queue;
+        depth[source] = 0;
+        queue.push(source);
+        while (!queue.empty()) {
+            auto vertex = queue.front();
+            queue.pop();
+            for (auto iter = graph.neighborsBegin(vertex); iter != graph.neighborsEnd(vertex); ++iter) {
+                if (depth[*iter] == Searching::BFSResult::unreached) {
+                    depth[*iter] = depth[vertex] + 1;
+                    queue.push(*iter);
+                }
+            }
+        }
+        return depth;
+    }
+
+    void expectValidTree(const CSRGraph<int, int>& graph, const Searching::BFSResult& result, std::uint32_t source) {
+        ASSERT_EQ(result.depth, referenceDepths(graph, source));
+        for (std::uint32_t vertex = 0; vertex < graph.numVertices(); vertex++) {
+            if (vertex == source || result.depth[vertex] == Searching::BFSResult::unreached) continue;
+            std::uint32_t parent = result.parent[vertex];
+            ASSERT_EQ(result.depth[parent] + 1, result.depth[vertex]);
+            ASSERT_TRUE(graph.hasEdge(graph.vertexOf(parent), graph.vertexOf(vertex)));
+        }
+    }
+
+    TEST(BFSTest, TopDownOnly) {
+        CSRGraph<int, int> graph = randomGraph(2000, 6000, false);
+        Searching::BFSOptions options;
+        options.threads = 4;
+        expectValidTree(graph, Searching::BFS(graph, 0, options), graph.idOf(0));
+    }
+
+    TEST(BFSTest, DirectionOptimizingMatchesReference) {
+        CSRGraph<int, int> graph = randomGraph(20000, 200000, true);
+        for (unsigned threads : {1u, 3u}) {
+            Searching::BFSOptions options;
+            options.threads = threads;
+            options.alpha = 2.0;  // Switch to bottom-up early so both directions run
+            expectValidTree(graph, Searching::BFS(graph, 5, options), graph.idOf(5));
+        }
+    }
+
+    TEST(BFSTest, UnreachableVertices) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges({{1, 2, 1}, {3, 4, 1}}, DAG);
+        CSRGraph<int, int> frozen = graph.freeze(true);
+        Searching::BFSResult result = Searching::BFS(frozen, 1);
+        ASSERT_EQ(result.depth[frozen.idOf(2)], 1);
+        ASSERT_EQ(result.parent[frozen.idOf(2)], frozen.idOf(1));
+        ASSERT_EQ(result.depth[frozen.idOf(3)], Searching::BFSResult::unreached);
+        ASSERT_EQ(result.parent[frozen.idOf(4)], Searching::BFSResult::unreached);
+    }
+
+    TEST(BFSTest, SourceIdOutOfRangeThrows) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges({{1, 2, 1}, {2, 3, 1}}, DAG);
+        CSRGraph<int, int> frozen = graph.freeze(true);
+        ASSERT_THROW(Searching::BFSFromId(frozen, frozen.idBound()), std::out_of_range);
+        ASSERT_THROW(Searching::BFSFromId(frozen, Searching::BFSResult::unreached), std::out_of_range);
+        ASSERT_THROW(Searching::BFS(CSRGraph<int, int>(), 1), std::runtime_error);
+    }
+}
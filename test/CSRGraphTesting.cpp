@@ -0,0 +1,58 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/Searching/DFS/DFS.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+namespace {
+
+    TEST(CSRGraphTest, FreezeKeepsVerticesAndEdges) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges({{1, 2, 5}, {1, 3, 6}, {3, 4, 7}}, DAG);
+        graph.addVertex(9);
+        CSRGraph<int, int> frozen = graph.freeze();
+        ASSERT_EQ(frozen.numVertices(), 5);
+        ASSERT_EQ(frozen.numEdges(), 3);
+        ASSERT_TRUE(frozen.hasEdge(1, 3));
+        ASSERT_FALSE(frozen.hasEdge(3, 1));
+        ASSERT_EQ(frozen.outDegree(frozen.idOf(9)), 0);
+        auto id = frozen.idOf(3);
+        ASSERT_EQ(frozen.outDegree(id), 1);
+        ASSERT_EQ(frozen.vertexOf(*frozen.neighborsBegin(id)), 4);
+        ASSERT_EQ(*frozen.weightsBegin(id), 7);
+        ASSERT_THROW(frozen.idOf(42), std::runtime_error);
+    }
+
+    TEST(CSRGraphTest, EmptyGraphFreezes) {
+        DerivedGraph<int, int> graph(DAG);
+        CSRGraph<int, int> frozen = graph.freeze();
+        ASSERT_EQ(frozen.numVertices(), 0);
+        ASSERT_EQ(frozen.numEdges(), 0);
+        ASSERT_FALSE(GraphAlgorithms::isCyclic(frozen));
+    }
+
+    TEST(CSRGraphTest, DFSMatchesAdjacencyListGraph) {
+        DerivedGraph<std::string, int> graph(UDG);
+        for (const char* name : {"a", "b", "c", "d", "e"}) graph.addVertex(name);
+        graph.addDirectionalEdge("a", "b", 1, false);
+        graph.addDirectionalEdge("b", "c", 1, false);
+        graph.addDirectionalEdge("a", "d", 1, true);
+        CSRGraph<std::string, int> frozen = graph.freeze();
+        std::vector<std::string> fromList = Searching::DFS(graph, std::string("a"));
+        std::vector<std::string> fromFrozen = Searching::DFS(frozen, std::string("a"));
+        ASSERT_EQ(fromFrozen.front(), "a");
+        std::sort(fromList.begin(), fromList.end());
+        std::sort(fromFrozen.begin(), fromFrozen.end());
+        ASSERT_EQ(fromFrozen, (std::vector<std::string>{"a", "b", "c", "d"}));
+        ASSERT_EQ(fromList, fromFrozen);
+    }
+
+    TEST(CSRGraphTest, IsCyclicOnFrozenGraph) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 0; i < 4; i++) graph.addVertex(i);
+        graph.addEdge(0, 1, 1, true);
+        graph.addEdge(1, 2, 1, true);
+        graph.addEdge(2, 3, 1, true);
+        ASSERT_FALSE(GraphAlgorithms::isCyclic(graph.freeze()));
+        graph.addEdge(3, 1, 1, false);
+        ASSERT_TRUE(GraphAlgorithms::isCyclic(graph.freeze()));
+    }
+}
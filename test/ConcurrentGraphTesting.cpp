@@ -0,0 +1,101 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/ConcurrentGraph.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentGraphTesting, ReadersSeeOnlyPublishedBatches) {
+    ConcurrentGraph<int, int> graph(DAG);
+    auto reader = graph.reader();
+    EXPECT_EQ(reader.pin()->numVertices(), 0u);
+
+    graph.staging().addVertex(1);
+    graph.staging().addVertex(2);
+    graph.staging().addEdge(1, 2, 5, false);
+    EXPECT_FALSE(reader.pin()->hasVertex(1));
+
+    graph.publish();
+    EXPECT_EQ(graph.version(), 1u);
+    auto snapshot = reader.pin();
+    EXPECT_TRUE(snapshot->hasEdge(1, 2));
+    EXPECT_FALSE(snapshot->hasEdge(2, 1));
+}
+
+TEST(ConcurrentGraphTesting, PinnedSnapshotOutlivesLaterPublishes) {
+    ConcurrentGraph<int, int> graph(UDG);
+    graph.staging().addVertex(0);
+    graph.publish();
+    auto reader = graph.reader();
+    {
+        auto snapshot = reader.pin();
+        for (int i = 1; i <= 3; i++) {
+            graph.staging().addVertex(i);
+            graph.staging().addEdge(0, i, i, false);
+            graph.publish();
+        }
+        // Everything retired since the pin must still be alive
+        EXPECT_EQ(graph.pendingReclamation(), 3u);
+        EXPECT_EQ(snapshot->numVertices(), 1u);
+        EXPECT_EQ(snapshot->numEdges(), 0u);
+    }
+    graph.publish();
+    EXPECT_EQ(graph.pendingReclamation(), 0u);
+    EXPECT_EQ(reader.pin()->numEdges(), 3u);
+}
+
+TEST(ConcurrentGraphTesting, ReaderSlotsAreLimitedAndRecycled) {
+    ConcurrentGraph<int, int> graph(UDG, 2);
+    {
+        auto first = graph.reader();
+        auto second = graph.reader();
+        EXPECT_THROW(graph.reader(), std::runtime_error);
+        auto moved = std::move(second);
+        EXPECT_THROW(graph.reader(), std::runtime_error);
+    }
+    EXPECT_NO_THROW(graph.reader());
+}
+
+// The writer grows a path 0 -> 1 -> ... one vertex per batch. Any snapshot a reader pins must be a whole path.
+TEST(ConcurrentGraphTesting, ConcurrentReadersObserveConsistentSnapshots) {
+    constexpr int batches = 300;
+    constexpr int readers = 4;
+    ConcurrentGraph<int, int> graph(DAG, readers);
+    graph.staging().addVertex(0);
+    graph.publish();
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&] {
+            auto reader = graph.reader();
+            unsigned int lastSeen = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                auto snapshot = reader.pin();
+                const unsigned int vertices = snapshot->numVertices();
+                if (vertices < lastSeen || snapshot->numEdges() + 1 != vertices) {
+                    inconsistent.fetch_add(1);
+                }
+                for (int v = 1; v < static_cast<int>(vertices); v++) {
+                    if (!snapshot->hasEdge(v - 1, v)) {
+                        inconsistent.fetch_add(1);
+                    }
+                }
+                lastSeen = vertices;
+            }
+        });
+    }
+    for (int v = 1; v <= batches; v++) {
+        graph.staging().addVertex(v);
+        graph.staging().addEdge(v - 1, v, 1, false);
+        graph.publish();
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(inconsistent.load(), 0);
+    graph.publish();
+    EXPECT_EQ(graph.pendingReclamation(), 0u);
+}
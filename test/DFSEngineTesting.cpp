@@ -0,0 +1,87 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/Searching/DFS/DFS.hpp"
+#include <gtest/gtest.h>
+namespace {
+
+    struct EdgeClassifier : Searching::DFSVisitor {
+        int discovered = 0, finished = 0, tree = 0, back = 0, forwardOrCross = 0;
+        void discoverVertex(std::uint32_t) { ++discovered; }
+        void finishVertex(std::uint32_t) { ++finished; }
+        void treeEdge(std::uint32_t, std::uint32_t) { ++tree; }
+        void backEdge(std::uint32_t, std::uint32_t) { ++back; }
+        void forwardOrCrossEdge(std::uint32_t, std::uint32_t) { ++forwardOrCross; }
+    };
+
+    TEST(DFSEngineTest, ClassifiesEdges) {
+        DerivedGraph<int, int> graph(UDG);
+        for (int i = 0; i < 4; i++) graph.addVertex(i);
+        graph.addEdge(0, 1, 1, true);
+        graph.addEdge(1, 2, 1, true);
+        graph.addEdge(0, 2, 1, true);  // forward edge
+        graph.addEdge(2, 0, 1, true);  // back edge
+        graph.addEdge(3, 2, 1, true);  // cross edge from a later root
+        Searching::DFSEngine<DerivedGraph<int, int>> engine(graph);
+        EdgeClassifier classifier;
+        ASSERT_TRUE(engine.visitAll(classifier));
+        ASSERT_EQ(classifier.discovered, 4);
+        ASSERT_EQ(classifier.finished, 4);
+        ASSERT_EQ(classifier.tree, 2);
+        ASSERT_EQ(classifier.back, 1);
+        ASSERT_EQ(classifier.forwardOrCross, 2);
+    }
+
+    TEST(DFSEngineTest, StopsWhenVisitorAsks) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges({{0, 1, 1}, {1, 2, 1}, {2, 3, 1}}, DAG);
+        struct StopAtTwo : Searching::DFSVisitor {
+            int seen = 0;
+            void discoverVertex(std::uint32_t) { ++seen; }
+            [[nodiscard]] bool stop() const { return seen == 2; }
+        } visitor;
+        Searching::DFSEngine<DerivedGraph<int, int>> engine(graph);
+        ASSERT_FALSE(engine.visit(graph.idOf(0), visitor));
+        ASSERT_EQ(visitor.seen, 2);
+    }
+
+    template <typename ColorMap>
+    void expectColorsRoundTrip() {
+        ColorMap colors(100);
+        for (std::uint32_t vertex = 0; vertex < 100; vertex++) colors.set(vertex, static_cast<Searching::DFSColor>(vertex % 3));
+        for (std::uint32_t vertex = 0; vertex < 100; vertex++) ASSERT_EQ(colors.get(vertex), vertex % 3);
+        colors.clear();
+        colors.resize(130);
+        for (std::uint32_t vertex = 0; vertex < 130; vertex++) ASSERT_EQ(colors.get(vertex), Searching::White);
+    }
+
+    TEST(DFSEngineTest, ColorMapsRoundTrip) {
+        expectColorsRoundTrip<Searching::PackedColorMap>();
+        expectColorsRoundTrip<Searching::EpochColorMap>();
+    }
+
+    TEST(DFSEngineTest, EpochEngineResetsBetweenSearches) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges({{0, 1, 1}, {1, 2, 1}, {3, 2, 1}, {2, 0, 1}}, UDG);
+        Searching::DFSEngine<DerivedGraph<int, int>, Searching::EpochColorMap> engine(graph);
+        for (int round = 0; round < 3; round++) {
+            EdgeClassifier classifier;
+            ASSERT_TRUE(engine.visit(graph.idOf(3), classifier));
+            ASSERT_EQ(classifier.discovered, 4);
+            ASSERT_EQ(classifier.back, 1);
+            ASSERT_TRUE(engine.discovered(graph.idOf(0)));
+            engine.reset();
+            ASSERT_FALSE(engine.discovered(graph.idOf(0)));
+        }
+    }
+
+    TEST(DFSEngineTest, DeepPathDoesNotOverflow) {
+        const int length = 2000000;
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 0; i < length; i++) graph.addVertex(i);
+        for (int i = 0; i + 1 < length; i++) graph.addEdge(i, i + 1, 1, true);
+        ASSERT_FALSE(GraphAlgorithms::isCyclic(graph));
+        ASSERT_EQ(Searching::DFS(graph, 0).size(), length);
+        CSRGraph<int, int> frozen = graph.freeze();
+        ASSERT_FALSE(GraphAlgorithms::isCyclic(frozen));
+        graph.addEdge(length - 1, 0, 1, false);
+        ASSERT_TRUE(GraphAlgorithms::isCyclic(graph));
+    }
+}
@@ -0,0 +1,93 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/GraphAlgorithms/DeltaStepping.hpp"
+#include <gtest/gtest.h>
+#include <random>
+namespace {
+
+    template <typename EdgeType>
+    CSRGraph<int, EdgeType> randomGraph(int vertices, int edges, EdgeType maxWeight, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> pick(0.0, static_cast<double>(maxWeight));
+        DerivedGraph<int, EdgeType> graph(UDG);
+        for (int i = 0; i < vertices; i++) graph.addVertex(i);
+        for (int i = 0; i < edges; i++) {
+            int source = rng() % vertices, destination = rng() % vertices;
+            if (!graph.hasEdge(source, destination)) graph.addEdge(source, destination, static_cast<EdgeType>(pick(rng)), false);
+        }
+        return graph.freeze();
+    }
+
+    template <typename EdgeType>
+    void expectMatchesDijkstra(const CSRGraph<int, EdgeType>& graph, const GraphAlgorithms::DeltaSteppingOptions& options) {
+        auto expected = GraphAlgorithms::dijkstra(graph, 0);
+        auto actual = GraphAlgorithms::deltaStepping(graph, 0, options);
+        const std::uint32_t source = graph.idOf(0);
+        for (std::uint32_t vertex = 0; vertex < graph.idBound(); vertex++) {
+            ASSERT_EQ(actual.parent[vertex] == actual.unreached, expected.parent[vertex] == expected.unreached);
+            if (actual.parent[vertex] == actual.unreached) continue;
+            ASSERT_EQ(actual.distance[vertex], expected.distance[vertex]);
+            if (vertex == source) {
+                ASSERT_EQ(actual.parent[vertex], source);
+                continue;
+            }
+            // The recorded parent's edge must produce exactly the recorded distance
+            std::uint32_t parent = actual.parent[vertex];
+            bool tight = false;
+            auto weight = graph.weightsBegin(parent);
+            for (auto target = graph.neighborsBegin(parent); target != graph.neighborsEnd(parent); ++target, ++weight) {
+                tight = tight || (*target == vertex && actual.distance[parent] + *weight == actual.distance[vertex]);
+            }
+            ASSERT_TRUE(tight);
+        }
+    }
+
+    TEST(DeltaSteppingTest, MatchesDijkstraAcrossDeltasAndThreads) {
+        CSRGraph<int, int> graph = randomGraph<int>(5000, 30000, 1000, 4);
+        for (unsigned threads : {1u, 3u, 8u}) {
+            for (double delta : {0.0, 1.0, 50.0, 1000.0, 1e9}) {
+                GraphAlgorithms::DeltaSteppingOptions options;
+                options.threads = threads;
+                options.delta = delta;
+                expectMatchesDijkstra(graph, options);
+            }
+        }
+    }
+
+    TEST(DeltaSteppingTest, ZeroAndFractionalWeights) {
+        GraphAlgorithms::DeltaSteppingOptions options;
+        options.threads = 4;
+        expectMatchesDijkstra(randomGraph<int>(3000, 12000, 0, 8), options);
+        expectMatchesDijkstra(randomGraph<int>(3000, 12000, 2, 9), options);
+        expectMatchesDijkstra(randomGraph<double>(3000, 12000, 1.0, 10), options);
+        options.delta = 0.05;
+        expectMatchesDijkstra(randomGraph<double>(3000, 12000, 1.0, 10), options);
+    }
+
+    TEST(DeltaSteppingTest, TinyDeltaStaysBounded) {
+        // Taken literally, max weight / delta would be a billion buckets per thread
+        CSRGraph<int, double> graph = randomGraph<double>(2000, 10000, 1000.0, 12);
+        GraphAlgorithms::DeltaSteppingOptions options;
+        options.delta = 1e-6;
+        for (unsigned threads : {1u, 4u}) {
+            options.threads = threads;
+            expectMatchesDijkstra(graph, options);
+        }
+    }
+
+    TEST(DeltaSteppingTest, PathAndNegativeWeights) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 0; i < 4; i++) graph.addVertex(i);
+        graph.addEdge(0, 1, 3, true);
+        graph.addEdge(1, 2, 4, true);
+        CSRGraph<int, int> frozen = graph.freeze();
+        auto tree = GraphAlgorithms::deltaStepping(frozen, 0);
+        ASSERT_EQ(tree.distance[frozen.idOf(2)], 7);
+        ASSERT_EQ(tree.parent[frozen.idOf(2)], frozen.idOf(1));
+        ASSERT_EQ(tree.parent[frozen.idOf(3)], tree.unreached);
+
+        graph.addEdge(2, 3, -1, true);
+        ASSERT_THROW(GraphAlgorithms::deltaStepping(graph.freeze(), 0), std::runtime_error);
+    }
+
+}  // namespace
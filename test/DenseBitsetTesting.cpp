@@ -0,0 +1,44 @@
+// Created by Aaron H on 5/28/24.
+#include "../Data-Structures/Array/DenseBitset.hpp"
+#include <gtest/gtest.h>
+#include <random>
+namespace {
+
+    TEST(DenseBitsetTest, BehavesLikeVectorBool) {
+        std::mt19937 rng(5);
+        DenseBitset marks(1000);
+        std::vector<bool> expected(1000, false);
+        for (int step = 0; step < 20000; step++) {
+            std::size_t index = rng() % 1000;
+            switch (rng() % 3) {
+                case 0:
+                    marks.set(index);
+                    expected[index] = true;
+                    break;
+                case 1:
+                    marks.reset(index);
+                    expected[index] = false;
+                    break;
+                default:
+                    ASSERT_EQ(marks.testAndSet(index), expected[index]);
+                    expected[index] = true;
+            }
+            ASSERT_EQ(marks.test(index), expected[index]);
+        }
+        marks.clear();
+        for (std::size_t index = 0; index < 1000; index++) ASSERT_FALSE(marks.test(index));
+    }
+
+    TEST(DenseBitsetTest, ResizeClearsNewAndDroppedBits) {
+        DenseBitset bits(70);
+        bits.set(69);
+        bits.set(3);
+        bits.resize(65);
+        bits.resize(130);
+        ASSERT_TRUE(bits.test(3));
+        ASSERT_FALSE(bits.test(69));
+        ASSERT_FALSE(bits.test(129));
+        ASSERT_EQ(bits.size(), 130);
+    }
+
+}  // namespace
@@ -1,11 +1,30 @@
 // Created by Aaron H on 5/28/24.
 #include "../Structures/ADT/Graph.hpp"
 #include <gtest/gtest.h>
+#include <memory_resource>
+#include <random>
+#include <type_traits>
 #include <unordered_set>
-#include <iostream>
-#include <chrono>
 namespace {
 
+    // Forwards to an upstream resource and counts what passes through
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        std::size_t allocations = 0;
+        std::size_t liveBytes = 0;
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            ++allocations;
+            liveBytes += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+            liveBytes -= bytes;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
     TEST(DerivedGraphTest, CopySemantics) {
         DerivedGraph<int, int> graph(DAG);
         graph.addVertex(1);
@@ -230,6 +249,96 @@ namespace {
         ASSERT_FALSE(graph.hasEdge(1, 1)); // After attempting to add a self-loop, this should still be false
     }
 
+    TEST(DerivedGraphTest, CycleDetectionAgainstInsertionOrder) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 1; i <= 4; i++) graph.addVertex(i);
+        // Every edge points backwards relative to the order the vertices were added in
+        graph.addEdge(4, 3, 1, true);
+        graph.addEdge(3, 2, 1, true);
+        graph.addEdge(2, 1, 1, true);
+        ASSERT_THROW(graph.addEdge(1, 4, 1, true), std::runtime_error);
+        ASSERT_THROW(graph.addEdge(1, 3, 1, true), std::runtime_error);
+        ASSERT_FALSE(graph.hasEdge(1, 4));
+        ASSERT_EQ(graph.numEdges(), 3);
+        ASSERT_NO_THROW(graph.addEdge(4, 1, 1, true));
+        graph.removeEdge(3, 2);
+        ASSERT_NO_THROW(graph.addEdge(2, 3, 1, true));
+    }
+
+    TEST(DerivedGraphTest, CycleDetectionAfterUncheckedEdges) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 1; i <= 3; i++) graph.addVertex(i);
+        graph.addEdge(1, 2, 1, true);
+        graph.addEdge(2, 1, 1, false);  // Cycle slipped in without a check
+        ASSERT_THROW(graph.addEdge(2, 3, 1, true), std::runtime_error);
+        graph.removeEdge(2, 1);  // Drops both directions
+        ASSERT_NO_THROW(graph.addEdge(2, 3, 1, true));
+        ASSERT_NO_THROW(graph.addEdge(1, 2, 1, true));
+        ASSERT_THROW(graph.addEdge(3, 1, 1, true), std::runtime_error);
+    }
+
+    TEST(DerivedGraphTest, CycleDetectionAfterVertexReinsertion) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 0; i < 200; i++) graph.addVertex(i);
+        for (int i = 0; i < 199; i++) graph.addEdge(i + 1, i, 1, true);
+        for (int i = 0; i < 150; i++) graph.removeVertex(i);
+        graph.addVertex(0);
+        graph.addEdge(0, 199, 1, true);
+        ASSERT_THROW(graph.addEdge(150, 0, 1, true), std::runtime_error);
+        ASSERT_EQ(graph.numEdges(), 50);
+    }
+
+    TEST(DerivedGraphTest, PredecessorsTrackMutations) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 1; i <= 4; i++) graph.addVertex(i);
+        graph.addEdge(1, 3, 1, true);
+        graph.addEdge(2, 3, 1, true);
+        graph.addEdge(3, 4, 1, true);
+        ASSERT_EQ(graph.inDegree(3), 2);
+        std::vector<int> predecessors(graph.predecessorsBegin(3), graph.predecessorsEnd(3));
+        std::sort(predecessors.begin(), predecessors.end());
+        ASSERT_EQ(predecessors, (std::vector<int>{1, 2}));
+        graph.removeEdge(1, 3);
+        ASSERT_EQ(graph.inDegree(3), 1);
+        graph.removeVertex(3);
+        ASSERT_EQ(graph.inDegree(4), 0);
+        ASSERT_EQ(graph.numEdges(), 0);
+        ASSERT_THROW(graph.inDegree(3), std::runtime_error);
+    }
+
+    TEST(DerivedGraphTest, RemoveVertexWithoutInEdgeIndex) {
+        DerivedGraph<int, int> graph(DAG, false);
+        for (int i = 1; i <= 3; i++) graph.addVertex(i);
+        graph.addEdge(1, 2, 1, true);
+        graph.addEdge(3, 2, 1, true);
+        ASSERT_FALSE(graph.hasInEdgeIndex());
+        ASSERT_THROW(graph.inDegree(2), std::runtime_error);
+        graph.removeVertex(2);
+        ASSERT_EQ(graph.numEdges(), 0);
+        ASSERT_EQ(graph.numVertices(), 2);
+    }
+
+    TEST(DerivedGraphTest, StatsFollowMutations) {
+        DerivedGraph<int, int> graph(UDG);
+        for (int i = 0; i < 6; i++) graph.addVertex(i);
+        for (int i = 1; i < 6; i++) graph.addEdge(0, i, 1, true);
+        graph.addEdge(1, 2, 1, true);
+        const GraphStats& stats = graph.stats();
+        ASSERT_EQ(stats.numVertices, 6);
+        ASSERT_EQ(stats.numEdges, 6);
+        ASSERT_EQ(stats.maxOutDegree, 5);
+        ASSERT_EQ(stats.outDegreeHistogram[0], 4);  // degree 0
+        ASSERT_EQ(stats.outDegreeHistogram[1], 1);  // degree 1
+        ASSERT_EQ(stats.outDegreeHistogram[3], 1);  // degree 5 falls in [4, 8)
+        graph.removeVertex(0);
+        ASSERT_EQ(graph.stats().numEdges, 1);
+        ASSERT_EQ(graph.stats().maxOutDegree, 1);
+        graph.removeEdge(1, 2);
+        ASSERT_EQ(graph.stats().maxOutDegree, 0);
+        ASSERT_EQ(graph.stats().outDegreeHistogram[0], 5);
+        ASSERT_EQ(graph.numEdges(), 0);
+    }
+
     TEST(DerivedGraphTest, StringVerticeHandling) {
         DerivedGraph<std::string, int> graph(DAG);
         graph.addVertex("one");
@@ -239,6 +348,24 @@ namespace {
         ASSERT_TRUE(graph.hasEdge("one", "two"));
     }
 
+    TEST(DerivedGraphTest, VertexIdsRecycledAfterRemoval) {
+        DerivedGraph<std::string, int> graph(DAG);
+        graph.addVertex("one");
+        graph.addVertex("two");
+        graph.addEdge("one", "two", 1, true);
+        auto oldId = graph.idOf("one");
+        graph.removeVertex("one");
+        graph.addVertex("three");
+        ASSERT_EQ(graph.idOf("three"), oldId);
+        ASSERT_FALSE(graph.hasEdge("three", "two"));
+        ASSERT_THROW(graph.idOf("one"), std::runtime_error);
+        graph.addEdge("two", "three", 4, true);
+        auto iter = graph.adjacentBegin("two");
+        ASSERT_EQ(iter->first, "three");
+        ASSERT_EQ(iter->second, 4);
+        ASSERT_EQ(graph.numEdges(), 1);
+    }
+
     TEST(DerivedGraphTest, InitializationWithPreexistingData) {
         // Assuming you have this method
         DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges({{1, 2, 1}, {2, 3, 2}}, DAG);
@@ -246,6 +373,33 @@ namespace {
         ASSERT_EQ(graph.numEdges(), 2);
     }
 
+    TEST(DerivedGraphTest, FromEdgesRejectsDuplicatesAndCycles) {
+        ASSERT_THROW((DerivedGraph<int, int>::from_edges({{1, 2, 1}, {2, 3, 1}, {1, 2, 5}}, DAG)), std::runtime_error);
+        try {
+            DerivedGraph<int, int>::from_edges({{1, 2, 1}, {2, 3, 1}, {3, 1, 1}, {3, 4, 1}}, DAG);
+            FAIL() << "Expected a cycle error";
+        } catch (const std::runtime_error& error) {
+            ASSERT_NE(std::string(error.what()).find("1 -> 2 -> 3 -> 1"), std::string::npos) << error.what();
+        }
+        // Undirected graphs store both directions and are not checked for cycles
+        DerivedGraph<int, int> undirected = DerivedGraph<int, int>::from_edges({{1, 2, 1}, {2, 1, 1}}, UDG);
+        ASSERT_EQ(undirected.numEdges(), 2);
+    }
+
+    TEST(DerivedGraphTest, FromEdgesLargeDag) {
+        std::vector<std::tuple<int, int, int>> edges;
+        for (int i = 0; i < 200000; i++) {
+            edges.emplace_back(i, i + 1, 1);
+            edges.emplace_back(i, (i * 7919) % 200000 + i + 2, 2);
+        }
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(edges, DAG);
+        ASSERT_EQ(graph.numEdges(), edges.size());
+        ASSERT_TRUE(graph.hasEdge(5, 6));
+        // The order established by the bulk load keeps later checked inserts incremental
+        ASSERT_THROW(graph.addEdge(200000, 0, 1, true), std::runtime_error);
+        ASSERT_NO_THROW(graph.addEdge(0, 200000, 1, true));
+    }
+
     TEST(DerivedGraphTest, LargeDataSet) {
         DerivedGraph<int, int> graph(DAG);
         for(int i=0 ; i<1000000 ; i++)
@@ -253,6 +407,70 @@ namespace {
         ASSERT_EQ(graph.numVertices(), 1000000);
     }
 
+    TEST(DerivedGraphTest, ArenaBackedGraph) {
+        CountingResource upstream;
+        std::vector<std::tuple<int, int, int>> edges;
+        for (int i = 0; i < 2000; i++) edges.emplace_back(i, i + 1, i);
+        {
+            std::pmr::monotonic_buffer_resource arena(&upstream);
+            DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges(edges, DAG, &arena);
+            ASSERT_EQ(graph.resource(), &arena);
+            graph.addVertex(-1);
+            graph.addEdge(-1, 0, 1, true);
+            graph.removeVertex(1000);
+            ASSERT_EQ(graph.numEdges(), 1999);
+            ASSERT_THROW(graph.addEdge(999, 0, 1, true), std::runtime_error);
+            // Thousands of vertex lists, but the arena only grows geometrically
+            ASSERT_GT(upstream.allocations, 0);
+            ASSERT_LT(upstream.allocations, 64);
+
+            DerivedGraph<int, int> copy(graph);
+            ASSERT_EQ(copy.resource(), std::pmr::get_default_resource());
+            graph = DerivedGraph<int, int>(DAG);
+            ASSERT_TRUE(copy.hasEdge(-1, 0));
+
+            // Move assignment keeps the target's resource, so the elements are copied across and may allocate
+            static_assert(!std::is_nothrow_move_assignable<DerivedGraph<int, int>>::value);
+            static_assert(std::is_nothrow_move_constructible<DerivedGraph<int, int>>::value);
+            DerivedGraph<int, int> onArena(DAG, &arena);
+            onArena = std::move(copy);
+            ASSERT_EQ(onArena.resource(), &arena);
+            ASSERT_TRUE(onArena.hasEdge(-1, 0));
+            ASSERT_EQ(onArena.numEdges(), 1999);
+        }
+        ASSERT_EQ(upstream.liveBytes, 0);
+    }
+
+    TEST(DerivedGraphTest, HubVerticesStayConsistent) {
+        const int spokes = 3 * DerivedGraph<int, int>::hubThreshold;
+        DerivedGraph<int, int> graph(DAG);
+        graph.addVertex(0);
+        for (int i = 1; i <= spokes; i++) {
+            graph.addVertex(i);
+            graph.addEdge(0, i, i, true);
+        }
+        ASSERT_THROW(graph.addEdge(0, spokes, 1, true), std::runtime_error);
+        ASSERT_THROW(graph.addEdge(spokes, 0, 1, true), std::runtime_error);
+        // Shrink through the hysteresis band and below it, mixing edge and vertex removals
+        for (int i = 1; i <= spokes - 10; i++) {
+            if (i % 2) graph.removeEdge(0, i);
+            else graph.removeVertex(i);
+            ASSERT_FALSE(graph.hasEdge(0, i));
+            ASSERT_TRUE(graph.hasEdge(0, i + 1));
+        }
+        ASSERT_EQ(graph.numEdges(), 10);
+        // And grow back past the threshold
+        for (int i = 1; i <= spokes - 10; i += 2) graph.addEdge(0, i, i, true);
+        for (int i = 1; i <= spokes; i++) ASSERT_EQ(graph.hasEdge(0, i), i % 2 == 1 || i > spokes - 10) << i;
+        ASSERT_THROW(graph.addEdge(0, 1, 1, true), std::runtime_error);
+
+        std::vector<std::tuple<int, int, int>> edges;
+        for (int i = 1; i <= spokes; i++) edges.emplace_back(0, i, 1);
+        DerivedGraph<int, int> bulk = DerivedGraph<int, int>::from_edges(edges, DAG);
+        ASSERT_TRUE(bulk.hasEdge(0, spokes));
+        ASSERT_THROW(bulk.addEdge(0, 1, 1, true), std::runtime_error);
+    }
+
     TEST(DerivedGraphTest, RandomVertexAdditionsAndDeletions) {
         DerivedGraph<int, int> graph(DAG);
         std::unordered_set<int> vertices;
@@ -372,23 +590,12 @@ namespace {
 // A performance test with a large number of vertices and edges.
     TEST(DerivedGraphTest, PerformanceTestLargeVerticesAndEdges) {
         DerivedGraph<int, int> graph(DAG);
-        auto startVertex = std::chrono::high_resolution_clock::now();
         for (int i = 0; i < 100000; i++) {
             graph.addVertex(i);
         }
-        auto endVertex = std::chrono::high_resolution_clock::now();
-        auto durationVertex = std::chrono::duration_cast<std::chrono::milliseconds>(endVertex - startVertex).count();
-        std::cout << "Total time for adding vertices: " << durationVertex << " ms" << std::endl;
-        auto startEdge = std::chrono::high_resolution_clock::now();
         for (int i = 0; i < 99999; i++) {
             graph.addEdge(i, i+1, 1, true);
-            if (i % 10000 == 0) {  // Reducing the frequency of console output to every 10000 iterations
-                std::cout << "Edge added " << i << "." << std::endl;
-            }
         }
-        auto endEdge = std::chrono::high_resolution_clock::now();
-        auto durationEdge = std::chrono::duration_cast<std::chrono::milliseconds>(endEdge - startEdge).count();
-        std::cout << "Total time for adding edges: " << durationEdge << " ms" << std::endl;
         ASSERT_EQ(100000, graph.numVertices());
         ASSERT_EQ(99999, graph.numEdges());
     }
@@ -409,4 +616,104 @@ namespace {
         ASSERT_EQ(25000, graph.numVertices());
         ASSERT_EQ(24999, graph.numEdges());
     }
-}
\ No newline at end of file
+
+    TEST(DerivedGraphTest, BatchAppliesAllChanges) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 0; i < 4; i++) graph.addVertex(i);
+        graph.addEdge(0, 1, 1, true);
+        graph.addEdge(1, 2, 1, true);
+        graph.addEdge(2, 3, 1, true);
+
+        auto batch = graph.batch();
+        batch.removeEdge(2, 3).removeVertex(1).addVertex(1).addVertex(4)
+             .addEdge(1, 0, 5).addEdge(3, 4, -2).addEdge(2, 1, 1);
+        ASSERT_EQ(batch.size(), 7);
+        batch.commit();
+        ASSERT_EQ(batch.size(), 0);
+
+        ASSERT_EQ(graph.numVertices(), 5);
+        ASSERT_EQ(graph.numEdges(), 3);
+        ASSERT_TRUE(graph.hasEdge(1, 0));
+        ASSERT_TRUE(graph.hasEdge(3, 4));
+        ASSERT_TRUE(graph.hasEdge(2, 1));
+        ASSERT_FALSE(graph.hasEdge(0, 1));
+        ASSERT_FALSE(graph.hasEdge(2, 3));
+        ASSERT_EQ(graph.stats().negativeWeightEdges, 1);
+        ASSERT_EQ(graph.inDegree(1), 1);
+        // The order is still valid afterwards, so checked inserts keep catching cycles
+        ASSERT_THROW(graph.addEdge(0, 2, 1, true), std::runtime_error);
+        graph.addEdge(4, 2, 1, true);
+    }
+
+    TEST(DerivedGraphTest, FailedBatchLeavesGraphUntouched) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 0; i < 3; i++) graph.addVertex(i);
+        graph.addEdge(0, 1, 1, true);
+        graph.addEdge(1, 2, 1, true);
+        auto expectUntouched = [&graph] {
+            ASSERT_EQ(graph.numVertices(), 3);
+            ASSERT_EQ(graph.numEdges(), 2);
+            ASSERT_TRUE(graph.hasEdge(0, 1));
+            ASSERT_TRUE(graph.hasEdge(1, 2));
+        };
+
+        auto cycle = graph.batch();
+        cycle.removeEdge(0, 1).addVertex(3).addEdge(2, 3, 1).addEdge(3, 1, 1).addEdge(2, 0, 1);
+        ASSERT_THROW(cycle.commit(), std::runtime_error);
+        expectUntouched();
+        ASSERT_EQ(cycle.size(), 5);
+
+        ASSERT_THROW(graph.batch().addEdge(0, 1, 1).commit(), std::runtime_error);
+        ASSERT_THROW(graph.batch().addVertex(3).addEdge(0, 3, 1).addEdge(0, 3, 2).commit(), std::runtime_error);
+        ASSERT_THROW(graph.batch().addVertex(3).addVertex(3).commit(), std::runtime_error);
+        ASSERT_THROW(graph.batch().addVertex(2).commit(), std::runtime_error);
+        ASSERT_THROW(graph.batch().removeVertex(2).addEdge(1, 2, 1).commit(), std::runtime_error);
+        ASSERT_THROW(graph.batch().removeVertex(2).removeVertex(2).commit(), std::runtime_error);
+        ASSERT_THROW(graph.batch().removeEdge(0, 2).commit(), std::runtime_error);
+        expectUntouched();
+
+        // Removing an edge lets the same batch add it back
+        graph.batch().removeEdge(0, 1).addEdge(0, 1, 7).commit();
+        ASSERT_EQ(graph.numEdges(), 2);
+        ASSERT_EQ(graph.adjacentIds(graph.idOf(0)).front().second, 7);
+    }
+
+    TEST(DerivedGraphTest, BatchMatchesSequentialInserts) {
+        // Edges arrive against the vertices' insertion order, so the batch has to reorder rather than append
+        std::mt19937 rng(7);
+        const int vertices = 2000;
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < 6 * vertices; i++) {
+            int a = rng() % vertices, b = rng() % vertices;
+            if (a != b) edges.emplace_back(std::max(a, b), std::min(a, b));
+        }
+        for (int i = 1; i < 200; i++) edges.emplace_back(vertices - 1, i);  // One hub
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        std::shuffle(edges.begin(), edges.end(), rng);
+
+        DerivedGraph<int, int> sequential(DAG);
+        DerivedGraph<int, int> batched(DAG);
+        auto batch = batched.batch();
+        for (int i = 0; i < vertices; i++) {
+            sequential.addVertex(i);
+            batch.addVertex(i);
+        }
+        for (const auto& edge : edges) {
+            sequential.addEdge(edge.first, edge.second, 1, true);
+            batch.addEdge(edge.first, edge.second, 1);
+        }
+        batch.commit();
+
+        ASSERT_EQ(batched.numEdges(), sequential.numEdges());
+        ASSERT_EQ(batched.stats().maxOutDegree, sequential.stats().maxOutDegree);
+        ASSERT_EQ(batched.stats().outDegreeHistogram, sequential.stats().outDegreeHistogram);
+        for (const auto& edge : edges) {
+            ASSERT_TRUE(batched.hasEdge(edge.first, edge.second));
+            ASSERT_FALSE(batched.hasEdge(edge.second, edge.first));
+            ASSERT_EQ(batched.inDegree(edge.second), sequential.inDegree(edge.second));
+        }
+        ASSERT_THROW(batched.addEdge(0, vertices - 1, 1, true), std::runtime_error);
+        ASSERT_THROW(batched.batch().addEdge(1, vertices - 1, 1).commit(), std::runtime_error);
+    }
+}
@@ -0,0 +1,93 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/EdgeListReader.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+namespace {
+
+    using IntEdges = std::vector<std::tuple<int, int, int>>;
+
+    IntEdges parse(const std::string& text, const EdgeListOptions& options = EdgeListOptions()) {
+        return parseEdgeList<int, int>(text.data(), text.data() + text.size(), options);
+    }
+
+    TEST(EdgeListReaderTest, ParsesSnapStyleLines) {
+        std::string text = "# Directed graph\n# FromNodeId\tToNodeId\n0\t1\n1 2 7\r\n\n  3,4,5\n5 6 # trailing\n6 7";
+        ASSERT_EQ(parse(text), (IntEdges{{0, 1, 1}, {1, 2, 7}, {3, 4, 5}, {5, 6, 1}, {6, 7, 1}}));
+    }
+
+    TEST(EdgeListReaderTest, FloatingPointWeights) {
+        std::string text = "1 2 0.25\n2 3 -1.5e1\n";
+        auto edges = parseEdgeList<long long, double>(text.data(), text.data() + text.size());
+        ASSERT_EQ(edges.size(), 2);
+        ASSERT_DOUBLE_EQ(std::get<2>(edges[0]), 0.25);
+        ASSERT_DOUBLE_EQ(std::get<2>(edges[1]), -15.0);
+
+        std::string floats = "1 2 3\n2 3 .5 # half\n3 4 1e-3\n";
+        auto narrow = parseEdgeList<int, float>(floats.data(), floats.data() + floats.size());
+        ASSERT_EQ(narrow, (std::vector<std::tuple<int, int, float>>{{1, 2, 3.0f}, {2, 3, 0.5f}, {3, 4, 1e-3f}}));
+    }
+
+    TEST(EdgeListReaderTest, RejectsFloatingPointFormsFromCharsRejects) {
+        auto parseDoubles = [](const std::string& text) {
+            return parseEdgeList<int, double>(text.data(), text.data() + text.size());
+        };
+        ASSERT_THROW(parseDoubles("1 2 +1.5\n"), std::runtime_error);
+        ASSERT_THROW(parseDoubles("1 2 0x1p3\n"), std::runtime_error);
+        ASSERT_THROW(parseDoubles("1 2 1.5.5\n"), std::runtime_error);
+        ASSERT_THROW(parseDoubles("1 2 1e999\n"), std::runtime_error);
+        ASSERT_THROW(parseDoubles("1 2 e\n"), std::runtime_error);
+    }
+
+    TEST(EdgeListReaderTest, RejectsMalformedLines) {
+        ASSERT_THROW(parse("1 2\n3\n"), std::runtime_error);
+        ASSERT_THROW(parse("1 2\nx 3\n"), std::runtime_error);
+        ASSERT_THROW(parse("1 2 3 4\n"), std::runtime_error);
+        ASSERT_THROW(parse("1 2x\n"), std::runtime_error);
+        ASSERT_THROW(parse("1 2 1.5\n"), std::runtime_error);
+    }
+
+    TEST(EdgeListReaderTest, TinyChunksMatchSingleChunk) {
+        std::mt19937 rng(3);
+        std::string text;
+        for (int i = 0; i < 5000; i++) {
+            if (i % 97 == 0) text += "# comment line\n";
+            text += std::to_string(rng() % 100000) + (i % 2 ? "\t" : " ") + std::to_string(rng() % 100000);
+            if (i % 3 == 0) text += " " + std::to_string(rng() % 50);
+            text += i % 5 == 0 ? "\r\n" : "\n";
+        }
+        EdgeListOptions sequential;
+        sequential.threads = 1;
+        sequential.chunkBytes = text.size();
+        IntEdges expected = parse(text, sequential);
+        ASSERT_EQ(expected.size(), 5000);
+        for (std::size_t chunkBytes : {1, 7, 64, 4096}) {
+            EdgeListOptions chunked;
+            chunked.threads = 4;
+            chunked.chunkBytes = chunkBytes;
+            ASSERT_EQ(parse(text, chunked), expected);
+        }
+    }
+
+    TEST(EdgeListReaderTest, LoadsFileIntoGraph) {
+        std::string path = ::testing::TempDir() + "edges.txt";
+        {
+            std::ofstream out(path);
+            out << "# tiny DAG\n1 2 4\n1 3 5\n3 4\n";
+        }
+        DerivedGraph<int, int> graph = loadEdgeList<int, int>(path, DAG);
+        ASSERT_EQ(graph.numVertices(), 4);
+        ASSERT_EQ(graph.numEdges(), 3);
+        ASSERT_TRUE(graph.hasEdge(3, 4));
+        std::remove(path.c_str());
+        ASSERT_THROW((loadEdgeList<int, int>(path, DAG)), std::runtime_error);
+    }
+
+    TEST(EdgeListReaderTest, EmptyFileGivesEmptyGraph) {
+        std::string path = ::testing::TempDir() + "empty_edges.txt";
+        std::ofstream(path).close();
+        ASSERT_EQ((loadEdgeList<int, int>(path, UDG).numVertices()), 0);
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,171 @@
+// Created by Aaron H on 5/28/24.
+#include "../Data-Structures/Hash-Tables/FlatHashMap.hpp"
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+namespace {
+
+    // Sends every key to the same probe sequence
+    struct ConstantHash {
+        std::size_t operator()(int) const { return 42; }
+    };
+
+    // Counts outstanding bytes and fails the allocation after the next failAfter successful ones
+    class FailingResource : public std::pmr::memory_resource {
+    public:
+        int failAfter = -1;
+        std::size_t outstanding = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            if (failAfter == 0) {
+                failAfter = -1;
+                throw std::bad_alloc();
+            }
+            if (failAfter > 0) --failAfter;
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    TEST(FlatHashMapTest, InsertFindErase) {
+        FlatHashMap<int, std::string> map;
+        ASSERT_TRUE(map.empty());
+        ASSERT_TRUE(map.find(1) == map.end());
+        ASSERT_TRUE(map.emplace(1, "one").second);
+        ASSERT_FALSE(map.emplace(1, "uno").second);
+        map[2] = "two";
+        ASSERT_EQ(map.size(), 2);
+        ASSERT_EQ(map.at(1), "one");
+        ASSERT_EQ(map.find(2)->second, "two");
+        ASSERT_THROW(map.at(3), std::out_of_range);
+        ASSERT_EQ(map.erase(1), 1);
+        ASSERT_EQ(map.erase(1), 0);
+        ASSERT_FALSE(map.contains(1));
+        ASSERT_EQ(map.count(2), 1);
+    }
+
+    TEST(FlatHashMapTest, MatchesUnorderedMapUnderRandomOperations) {
+        std::mt19937 rng(11);
+        FlatHashMap<int, int> map;
+        std::unordered_map<int, int> reference;
+        for (int step = 0; step < 200000; step++) {
+            int key = static_cast<int>(rng() % 5000);
+            switch (rng() % 3) {
+                case 0:
+                    map[key] = step;
+                    reference[key] = step;
+                    break;
+                case 1:
+                    ASSERT_EQ(map.erase(key), reference.erase(key));
+                    break;
+                default:
+                    ASSERT_EQ(map.contains(key), reference.count(key) == 1);
+                    if (reference.count(key)) {
+                        ASSERT_EQ(map.at(key), reference.at(key));
+                    }
+            }
+        }
+        ASSERT_EQ(map.size(), reference.size());
+        std::size_t visited = 0;
+        for (const auto& entry : map) {
+            ASSERT_EQ(reference.at(entry.first), entry.second);
+            visited++;
+        }
+        ASSERT_EQ(visited, reference.size());
+    }
+
+    TEST(FlatHashMapTest, TombstonesAreReclaimed) {
+        FlatHashMap<int, int> map;
+        map.reserve(100);
+        const std::size_t capacity = map.capacity();
+        // Churn far past capacity; tombstones get purged instead of growing the table
+        for (int i = 0; i < 100000; i++) {
+            map[i] = i;
+            map.erase(i);
+        }
+        ASSERT_TRUE(map.empty());
+        ASSERT_EQ(map.capacity(), capacity);
+    }
+
+    TEST(FlatHashMapTest, SurvivesFullCollisions) {
+        FlatHashMap<int, int, ConstantHash> map;
+        for (int i = 0; i < 300; i++) map[i] = -i;
+        for (int i = 0; i < 300; i += 2) map.erase(i);
+        for (int i = 0; i < 300; i++) ASSERT_EQ(map.contains(i), i % 2 == 1);
+        ASSERT_EQ(map.at(299), -299);
+    }
+
+    TEST(FlatHashMapTest, EraseDuringIteration) {
+        FlatHashMap<int, int> map;
+        for (int i = 0; i < 1000; i++) map[i] = i;
+        for (auto it = map.begin(); it != map.end();) {
+            it = it->first % 3 == 0 ? map.erase(it) : std::next(it);
+        }
+        ASSERT_EQ(map.size(), 666);
+        ASSERT_FALSE(map.contains(999));
+        ASSERT_TRUE(map.contains(998));
+    }
+
+    TEST(FlatHashMapTest, CopyAndMove) {
+        FlatHashMap<std::string, int> map;
+        for (int i = 0; i < 100; i++) map[std::to_string(i)] = i;
+        FlatHashMap<std::string, int> copy(map);
+        map["0"] = -1;
+        ASSERT_EQ(copy.at("0"), 0);
+        FlatHashMap<std::string, int> moved(std::move(map));
+        ASSERT_EQ(moved.at("0"), -1);
+        ASSERT_TRUE(map.empty());
+        copy = moved;
+        ASSERT_EQ(copy.at("0"), -1);
+        moved = FlatHashMap<std::string, int>();
+        ASSERT_TRUE(moved.empty());
+    }
+
+    TEST(FlatHashMapTest, PolymorphicAllocator) {
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::monotonic_buffer_resource otherArena;
+        PmrFlatHashMap<int, int> map(&arena);
+        for (int i = 0; i < 1000; i++) map[i] = i * i;
+        ASSERT_EQ(map.get_allocator().resource(), &arena);
+        PmrFlatHashMap<int, int> other(&otherArena);
+        other = std::move(map);  // Different resources: elements move, storage stays in otherArena
+        ASSERT_EQ(other.get_allocator().resource(), &otherArena);
+        ASSERT_EQ(other.at(30), 900);
+        ASSERT_TRUE(map.empty());
+    }
+
+    TEST(FlatHashMapTest, MoveAssignmentIsNoexceptOnlyForEqualAllocators) {
+        static_assert(std::is_nothrow_move_assignable<FlatHashMap<int, int>>::value);
+        static_assert(!std::is_nothrow_move_assignable<PmrFlatHashMap<int, int>>::value);
+        static_assert(std::is_nothrow_move_assignable<FlatHashSet<int>>::value);
+        static_assert(!std::is_nothrow_move_assignable<PmrFlatHashSet<int>>::value);
+        static_assert(std::is_nothrow_move_constructible<PmrFlatHashMap<int, int>>::value);
+    }
+
+    TEST(FlatHashMapTest, FailedRehashLeavesMapIntact) {
+        // 0 fails the control array, 1 the slot array
+        for (int failAfter : {0, 1}) {
+            FailingResource resource;
+            {
+                PmrFlatHashMap<int, int> map(&resource);
+                for (int i = 0; i < 100; i++) map[i] = i * 3;
+                resource.failAfter = failAfter;
+                ASSERT_THROW(map.reserve(100000), std::bad_alloc);
+                ASSERT_EQ(map.size(), 100);
+                for (int i = 0; i < 100; i++) ASSERT_EQ(map.at(i), i * 3);
+                for (int i = 100; i < 1000; i++) map[i] = i * 3;
+                ASSERT_EQ(map.at(999), 2997);
+            }
+            ASSERT_EQ(resource.outstanding, 0);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/GraphFile.hpp"
+#include "../Algorithms/Searching/DFS/DFSEngine.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+namespace {
+
+    std::string tempGraphPath(const char* name) {
+        return ::testing::TempDir() + name;
+    }
+
+    TEST(GraphFileTest, RoundTripMatchesFrozenGraph) {
+        DerivedGraph<int, double> graph = DerivedGraph<int, double>::from_edges({{7, 3, 1.5}, {7, 9, 2.5}, {3, 9, 0.5}}, DAG);
+        graph.addVertex(-4);
+        std::string path = tempGraphPath("roundtrip.uag");
+        writeGraphFile(graph, path, true);
+        CSRGraph<int, double> frozen = graph.freeze(true);
+        MappedCSRGraph<int, double> mapped(path);
+        ASSERT_EQ(mapped.numVertices(), 4);
+        ASSERT_EQ(mapped.numEdges(), 3);
+        for (std::uint32_t id = 0; id < frozen.idBound(); id++) {
+            ASSERT_EQ(mapped.vertexOf(id), frozen.vertexOf(id));
+            ASSERT_EQ(mapped.idOf(frozen.vertexOf(id)), id);
+            ASSERT_EQ(mapped.outDegree(id), frozen.outDegree(id));
+            ASSERT_EQ(mapped.inDegree(id), frozen.inDegree(id));
+            for (std::size_t k = 0; k < frozen.outDegree(id); k++) {
+                ASSERT_EQ(mapped.neighborAt(id, k), frozen.neighborAt(id, k));
+                ASSERT_EQ(mapped.weightsBegin(id)[k], frozen.weightsBegin(id)[k]);
+            }
+        }
+        ASSERT_TRUE(mapped.hasEdge(7, 9));
+        ASSERT_FALSE(mapped.hasEdge(9, 7));
+        ASSERT_FALSE(mapped.hasVertex(8));
+        ASSERT_THROW(mapped.idOf(8), std::runtime_error);
+        std::remove(path.c_str());
+    }
+
+    TEST(GraphFileTest, MappedGraphRunsDFSEngine) {
+        DerivedGraph<int, int> graph = DerivedGraph<int, int>::from_edges({{0, 1, 1}, {1, 2, 1}, {2, 0, 1}, {3, 4, 1}}, UDG);
+        std::string path = tempGraphPath("dfs.uag");
+        writeGraphFile(graph, path);
+        MappedCSRGraph<int, int> mapped(path);
+        ASSERT_FALSE(mapped.hasInEdges());
+        Searching::DFSEngine<MappedCSRGraph<int, int>> engine(mapped);
+        Searching::DFSVisitor visitor;
+        engine.visit(mapped.idOf(0), visitor);
+        ASSERT_TRUE(engine.discovered(mapped.idOf(2)));
+        ASSERT_FALSE(engine.discovered(mapped.idOf(3)));
+
+        MappedCSRGraph<int, int> moved(std::move(mapped));
+        ASSERT_EQ(moved.numEdges(), 4);
+        std::remove(path.c_str());
+    }
+
+    TEST(GraphFileTest, EmptyGraphRoundTrips) {
+        std::string path = tempGraphPath("empty.uag");
+        writeGraphFile(DerivedGraph<int, int>(DAG), path);
+        MappedCSRGraph<int, int> mapped(path);
+        ASSERT_EQ(mapped.numVertices(), 0);
+        ASSERT_FALSE(mapped.hasVertex(0));
+        std::remove(path.c_str());
+    }
+
+    TEST(GraphFileTest, RejectsMismatchedOrCorruptFiles) {
+        std::string path = tempGraphPath("corrupt.uag");
+        writeGraphFile(DerivedGraph<int, int>::from_edges({{1, 2, 3}}, DAG), path);
+        ASSERT_THROW((MappedCSRGraph<long long, int>(path)), std::runtime_error);
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.write("NOTGRAPH", 8);
+        }
+        ASSERT_THROW((MappedCSRGraph<int, int>(path)), std::runtime_error);
+        std::remove(path.c_str());
+        ASSERT_THROW((MappedCSRGraph<int, int>(path)), std::runtime_error);
+    }
+
+    // Overwrites one uint32 or uint64 inside the section that starts at the header field selected by offsetOf
+    template<typename T>
+    void patchGraphFile(const std::string& path, std::uint64_t GraphFileHeader::* offsetOf, std::uint64_t index, T value) {
+        GraphFileHeader header{};
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        file.seekp(static_cast<std::streamoff>(header.*offsetOf + index * sizeof(T)));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    TEST(GraphFileTest, DetectsCorruptRows) {
+        std::string path = tempGraphPath("rows.uag");
+        auto graph = DerivedGraph<int, int>::from_edges({{1, 2, 1}, {1, 3, 1}, {2, 3, 1}}, DAG);
+        writeGraphFile(graph, path, true);
+        MappedCSRGraph<int, int>(path).verify();
+
+        // A bad last in-edge offset is caught on open, like a bad out-edge one
+        patchGraphFile<std::uint64_t>(path, &GraphFileHeader::inOffsetsOffset, 3, 7);
+        ASSERT_THROW((MappedCSRGraph<int, int>(path)), std::runtime_error);
+
+        // Interior damage only shows up in verify()
+        writeGraphFile(graph, path, true);
+        patchGraphFile<std::uint32_t>(path, &GraphFileHeader::inSourcesOffset, 1, 99);
+        ASSERT_THROW((MappedCSRGraph<int, int>(path).verify()), std::runtime_error);
+        writeGraphFile(graph, path, true);
+        patchGraphFile<std::uint32_t>(path, &GraphFileHeader::targetsOffset, 0, 3);
+        ASSERT_THROW((MappedCSRGraph<int, int>(path).verify()), std::runtime_error);
+        writeGraphFile(graph, path, true);
+        patchGraphFile<std::uint64_t>(path, &GraphFileHeader::offsetsOffset, 1, 5);
+        ASSERT_THROW((MappedCSRGraph<int, int>(path).verify()), std::runtime_error);
+        writeGraphFile(graph, path, true);
+        patchGraphFile<std::uint32_t>(path, &GraphFileHeader::sortedIndexOffset, 0, 2);
+        ASSERT_THROW((MappedCSRGraph<int, int>(path).verify()), std::runtime_error);
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,125 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/GraphAlgorithms/IsCyclic.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using GraphMetrics::LatencyHistogram;
+using GraphMetrics::Operation;
+using GraphMetrics::Work;
+
+TEST(GraphMetricsTesting, SmallValuesGetExactBuckets) {
+    for (std::uint64_t value = 0; value < LatencyHistogram::subBuckets; value++) {
+        EXPECT_EQ(LatencyHistogram::bucketOf(value), value);
+        EXPECT_EQ(LatencyHistogram::bucketLimit(value), value);
+    }
+}
+
+TEST(GraphMetricsTesting, BucketsBoundRelativeError) {
+    const std::uint64_t values[] = {16, 17, 31, 32, 33, 1000, 123456789, std::uint64_t{1} << 40, ~std::uint64_t{0}};
+    for (std::uint64_t value : values) {
+        const std::size_t bucket = LatencyHistogram::bucketOf(value);
+        ASSERT_LT(bucket, LatencyHistogram::bucketCount);
+        const std::uint64_t limit = LatencyHistogram::bucketLimit(bucket);
+        EXPECT_GE(limit, value);
+        EXPECT_LE(limit - value, value / LatencyHistogram::subBuckets);
+        if (bucket > 0) {
+            EXPECT_LT(LatencyHistogram::bucketLimit(bucket - 1), value);
+        }
+    }
+    EXPECT_EQ(LatencyHistogram::bucketOf(~std::uint64_t{0}), LatencyHistogram::bucketCount - 1);
+}
+
+TEST(GraphMetricsTesting, PercentilesAndMerge) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+    for (std::uint64_t value = 1; value <= 10; value++) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), 10u);
+    EXPECT_EQ(histogram.percentile(0.5), 5u);
+    EXPECT_EQ(histogram.percentile(0.9), 9u);
+    EXPECT_EQ(histogram.max(), 10u);
+
+    LatencyHistogram slow;
+    slow.record(1000, 10);
+    histogram.merge(slow);
+    EXPECT_EQ(histogram.count(), 20u);
+    EXPECT_EQ(histogram.percentile(0.5), 10u);
+    EXPECT_GE(histogram.max(), 1000u);
+    EXPECT_LE(histogram.max(), 1000u + 1000u / LatencyHistogram::subBuckets);
+}
+
+TEST(GraphMetricsTesting, JsonListsEveryOperationAndCounter) {
+    GraphMetrics::Snapshot snapshot;
+    snapshot.operations[static_cast<std::size_t>(Operation::AddEdge)].calls = 3;
+    const std::string json = snapshot.toJson();
+    EXPECT_EQ(json.front(), '{');
+    EXPECT_EQ(json.back(), '}');
+    EXPECT_NE(json.find("\"addEdge\": {\"calls\": 3,"), std::string::npos);
+    EXPECT_NE(json.find("\"isCyclic\""), std::string::npos);
+    EXPECT_NE(json.find("\"p99\""), std::string::npos);
+    EXPECT_NE(json.find("\"rehashes\": 0"), std::string::npos);
+}
+
+#if defined(GRAPH_INSTRUMENTATION)
+
+TEST(GraphMetricsTesting, GraphOperationsAreCounted) {
+    GraphMetrics::reset();
+    DerivedGraph<int, int> graph(DAG);
+    for (int i = 0; i < 100; i++) {
+        graph.addVertex(i);
+    }
+    for (int i = 0; i + 1 < 100; i++) {
+        graph.addEdge(i, i + 1, 1, false);
+    }
+    EXPECT_TRUE(graph.hasEdge(0, 1));
+    EXPECT_FALSE(graph.hasEdge(1, 0));
+    EXPECT_FALSE(GraphAlgorithms::isCyclic(graph));
+
+    const GraphMetrics::Snapshot snapshot = GraphMetrics::snapshot();
+    EXPECT_EQ(snapshot[Operation::AddVertex].calls, 100u);
+    EXPECT_EQ(snapshot[Operation::AddVertex].latencyNanos.count(), 100u);
+    EXPECT_GT(snapshot[Operation::AddVertex].workOf(Work::Rehashes), 0u);
+    EXPECT_EQ(snapshot[Operation::AddEdge].calls, 99u);
+    EXPECT_EQ(snapshot[Operation::HasEdge].calls, 2u);
+    // hasEdge(0, 1) stops at its only entry; vertex 1's list holds just its edge to 2
+    EXPECT_EQ(snapshot[Operation::HasEdge].workOf(Work::AdjacencyScanned), 2u);
+    EXPECT_EQ(snapshot[Operation::IsCyclic].calls, 1u);
+    EXPECT_EQ(snapshot[Operation::IsCyclic].workOf(Work::VerticesVisited), 100u);
+}
+
+TEST(GraphMetricsTesting, ShardsOfExitedThreadsAreKept) {
+    GraphMetrics::reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t] {
+            DerivedGraph<int, int> graph(UDG);
+            for (int i = 0; i < 50; i++) {
+                graph.addVertex(t * 100 + i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(GraphMetrics::snapshot()[Operation::AddVertex].calls, 200u);
+}
+
+#else
+
+TEST(GraphMetricsTesting, DisabledHooksRecordNothing) {
+    DerivedGraph<int, int> graph(DAG);
+    graph.addVertex(1);
+    graph.addVertex(2);
+    graph.addEdge(1, 2, 1, false);
+    EXPECT_TRUE(graph.hasEdge(1, 2));
+    const GraphMetrics::Snapshot snapshot = GraphMetrics::snapshot();
+    for (const auto& metrics : snapshot.operations) {
+        EXPECT_EQ(metrics.calls, 0u);
+        EXPECT_EQ(metrics.latencyNanos.count(), 0u);
+    }
+}
+
+#endif
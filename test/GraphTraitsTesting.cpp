@@ -0,0 +1,90 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Structures/ADT/GraphFile.hpp"
+#include "../Algorithms/GraphAlgorithms/GraphTraits.hpp"
+#include "../Algorithms/GraphAlgorithms/IsCyclic.hpp"
+#include "../Algorithms/GraphAlgorithms/ShortestPaths.hpp"
+#include "../Algorithms/GraphAlgorithms/TopologicalSort.hpp"
+#include "../Algorithms/Searching/DFS/DFS.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+namespace {
+
+    using namespace GraphAlgorithms;
+
+    // The smallest backend the algorithms accept: a fixed ring of string-named vertices with unit weights
+    class Ring {
+    public:
+        using Weight = int;
+        explicit Ring(std::vector<std::string> names, bool closed) : names(std::move(names)), closed(closed) {}
+        [[nodiscard]] std::uint32_t idBound() const { return static_cast<std::uint32_t>(names.size()); }
+        [[nodiscard]] bool containsId(std::uint32_t) const { return true; }
+        [[nodiscard]] std::size_t outDegree(std::uint32_t id) const { return closed || id + 1 < names.size() ? 1 : 0; }
+        [[nodiscard]] std::uint32_t neighborAt(std::uint32_t id, std::size_t) const { return static_cast<std::uint32_t>((id + 1) % names.size()); }
+        const std::string& vertexOf(std::uint32_t id) const { return names[id]; }
+        std::uint32_t idOf(const std::string& name) const {
+            return static_cast<std::uint32_t>(std::find(names.begin(), names.end(), name) - names.begin());
+        }
+    private:
+        std::vector<std::string> names;
+        bool closed;
+    };
+
+    static_assert(IsIdGraph<Ring>::value);
+    static_assert(IsWeightedIdGraph<Ring>::value);
+    static_assert(!IsMutableGraph<Ring>::value);
+    static_assert(IsIdGraph<CSRGraph<int, double>>::value && !IsMutableGraph<CSRGraph<int, double>>::value);
+    static_assert(IsIdGraph<MappedCSRGraph<int, int>>::value);
+    static_assert(IsMutableGraph<DerivedGraph<int, int>>::value);
+    static_assert(IsMutableGraph<DagGraph<std::string, float>>::value && HasAdjacencyLists<DagGraph<std::string, float>>::value);
+    static_assert(!IsIdGraph<std::vector<int>>::value);
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+    static_assert(IdGraph<Ring> && WeightedIdGraph<CSRGraph<int, int>> && MutableGraph<UdgGraph<int, int>> && !MutableGraph<Ring>);
+#endif
+    // A static policy is empty, so fixing the type costs no storage over the runtime one
+    static_assert(sizeof(DagGraph<int, int>) <= sizeof(DerivedGraph<int, int>));
+
+    TEST(GraphTraitsTest, AlgorithmsRunOnAnyConformingBackend) {
+        Ring open({"a", "b", "c", "d"}, false);
+        Ring closed({"a", "b", "c"}, true);
+        EXPECT_FALSE(isCyclic(open));
+        EXPECT_TRUE(isCyclic(closed));
+        EXPECT_EQ(findCycle(closed), (std::vector<std::string>{"a", "b", "c"}));
+        EXPECT_EQ(Searching::DFS(open, "b"), (std::vector<std::string>{"b", "c", "d"}));
+        EXPECT_EQ(topologicalSort(open, TopologicalMethod::DepthFirst), (std::vector<std::string>{"a", "b", "c", "d"}));
+        EXPECT_THROW(topologicalSort(closed), std::runtime_error);
+    }
+
+    TEST(GraphTraitsTest, StaticTypePoliciesMatchTheRuntimeOne) {
+        DagGraph<int, int> dag;
+        UdgGraph<int, int> udg;
+        DerivedGraph<int, int> runtime(DAG);
+        EXPECT_EQ(dag.type(), DAG);
+        EXPECT_EQ(udg.type(), UDG);
+        for (int i = 0; i < 3; i++) {
+            dag.addVertex(i);
+            udg.addVertex(i);
+            runtime.addVertex(i);
+        }
+        dag.addEdge(0, 1, 1, true);
+        dag.addEdge(1, 2, 1, true);
+        runtime.addEdge(0, 1, 1, true);
+        runtime.addEdge(1, 2, 1, true);
+        EXPECT_THROW(dag.addEdge(2, 0, 1, true), std::runtime_error);
+        EXPECT_THROW(runtime.addEdge(2, 0, 1, true), std::runtime_error);
+        udg.addDirectionalEdge(0, 1, 1, false);
+        udg.addEdge(1, 2, 1, true);
+        udg.addEdge(2, 0, 1, true);
+        EXPECT_TRUE(isCyclic(udg));
+        EXPECT_FALSE(isCyclic(dag));
+
+        EXPECT_THROW((DagGraph<int, int>(UDG)), std::runtime_error);
+        EXPECT_NO_THROW((UdgGraph<int, int>(UDG)));
+        std::vector<std::tuple<int, int, int>> cycle{{0, 1, 1}, {1, 0, 1}};
+        EXPECT_THROW((DagGraph<int, int>::from_edges(cycle, DAG)), std::runtime_error);
+        EXPECT_EQ((UdgGraph<int, int>::from_edges(cycle, UDG).numEdges()), 2);
+        EXPECT_EQ(dijkstra(dag, 0).distance[dag.idOf(2)], 2);
+    }
+
+}  // namespace
@@ -0,0 +1,175 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Structures/ADT/GraphFile.hpp"
+#include "../Algorithms/GraphAlgorithms/PageRank.hpp"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+namespace {
+
+    // Directed graph on vertices 0..vertices-1; UDG with one-way edges, since a DAG would refuse cycles
+    DerivedGraph<int, int> directedGraph(int vertices, const std::vector<std::pair<int, int>>& edges) {
+        DerivedGraph<int, int> graph(UDG);
+        for (int v = 0; v < vertices; v++) graph.addVertex(v);
+        for (const auto& [source, destination] : edges) graph.addDirectionalEdge(source, destination, 1, true, false);
+        return graph;
+    }
+
+    // Random directed edges without duplicates; only the first sources vertices get out-edges
+    std::vector<std::pair<int, int>> randomEdges(int vertices, int edges, int sources, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::vector<bool>> seen(vertices, std::vector<bool>(vertices, false));
+        std::vector<std::pair<int, int>> list;
+        for (int i = 0; i < edges; i++) {
+            const int a = static_cast<int>(rng() % sources), b = static_cast<int>(rng() % vertices);
+            if (a != b && !seen[a][b]) {
+                seen[a][b] = true;
+                list.emplace_back(a, b);
+            }
+        }
+        return list;
+    }
+
+    // Dense power iteration straight from the definition, indexed by vertex
+    std::vector<double> referencePageRank(int vertices, const std::vector<std::pair<int, int>>& edges, double damping, int iterations) {
+        std::vector<int> outDegree(vertices, 0);
+        for (const auto& edge : edges) outDegree[edge.first]++;
+        std::vector<double> rank(vertices, 1.0 / vertices);
+        for (int iteration = 0; iteration < iterations; iteration++) {
+            double dangling = 0.0;
+            for (int v = 0; v < vertices; v++) {
+                if (outDegree[v] == 0) dangling += rank[v];
+            }
+            std::vector<double> next(vertices, (1.0 - damping + damping * dangling) / vertices);
+            for (const auto& [source, destination] : edges) next[destination] += damping * rank[source] / outDegree[source];
+            rank = std::move(next);
+        }
+        return rank;
+    }
+
+}
+
+TEST(PageRankTesting, CycleGivesUniformScores) {
+    const auto graph = directedGraph(5, {{0, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 0}});
+    const auto result = GraphAlgorithms::pageRank(graph.freeze(true));
+    ASSERT_TRUE(result.converged);
+    ASSERT_EQ(result.scores.size(), 5u);
+    for (double score : result.scores) {
+        EXPECT_NEAR(score, 0.2, 1e-12);
+    }
+}
+
+TEST(PageRankTesting, RandomGraphsMatchDenseReference) {
+    for (unsigned seed : {1u, 2u, 3u}) {
+        const int vertices = 200;
+        const auto edges = randomEdges(vertices, 1500, 180, seed);  // Vertices 180 and up are dangling
+        const auto graph = directedGraph(vertices, edges);
+        const auto frozen = graph.freeze(true);
+        const auto expected = referencePageRank(vertices, edges, 0.85, 200);
+
+        GraphAlgorithms::PageRankOptions options;
+        options.tolerance = 1e-12;
+        options.maxIterations = 200;
+        for (unsigned threads : {1u, 4u}) {
+            options.threads = threads;
+            const auto result = GraphAlgorithms::pageRank(frozen, options);
+            EXPECT_TRUE(result.converged);
+            EXPECT_LT(result.residual, options.tolerance);
+            EXPECT_NEAR(std::accumulate(result.scores.begin(), result.scores.end(), 0.0), 1.0, 1e-9);
+            for (int v = 0; v < vertices; v++) {
+                ASSERT_NEAR(result.scores[frozen.idOf(v)], expected[v], 1e-10) << "vertex " << v << ", seed " << seed;
+            }
+        }
+    }
+}
+
+TEST(PageRankTesting, DanglingVerticesSpreadTheirRank) {
+    // 0 -> 1 and nothing else. Both vertices get b = (1 - d + d r1) / 2 from jumps and the dangling vertex 1, and
+    // 1 gets d r0 on top, so r0 = b, r1 = (1 + d) b and b = 1 / (2 + d)
+    const auto frozen = directedGraph(2, {{0, 1}}).freeze(true);
+    GraphAlgorithms::PageRankOptions options;
+    options.tolerance = 1e-14;
+    options.maxIterations = 1000;
+    const auto result = GraphAlgorithms::pageRank(frozen, options);
+    const double d = options.damping;
+    ASSERT_TRUE(result.converged);
+    EXPECT_NEAR(result.scores[frozen.idOf(0)], 1.0 / (2.0 + d), 1e-12);
+    EXPECT_NEAR(result.scores[frozen.idOf(1)], (1.0 + d) / (2.0 + d), 1e-12);
+}
+
+TEST(PageRankTesting, FloatScoresTrackDoubleScores) {
+    const int vertices = 500;
+    const auto edges = randomEdges(vertices, 4000, vertices, 7);
+    const auto frozen = directedGraph(vertices, edges).freeze(true);
+    GraphAlgorithms::PageRankOptions options;
+    options.tolerance = 1e-5;
+    const auto single = GraphAlgorithms::pageRank<float>(frozen, options);
+    const auto full = GraphAlgorithms::pageRank<double>(frozen, options);
+    ASSERT_TRUE(single.converged);
+    ASSERT_EQ(single.scores.size(), full.scores.size());
+    for (std::size_t id = 0; id < full.scores.size(); id++) {
+        EXPECT_NEAR(single.scores[id], full.scores[id], 1e-5);
+    }
+}
+
+TEST(PageRankTesting, StopsAtMaxIterations) {
+    const auto frozen = directedGraph(4, {{0, 1}, {0, 2}, {1, 2}, {2, 0}, {3, 2}}).freeze(true);
+    GraphAlgorithms::PageRankOptions options;
+    options.maxIterations = 1;
+    options.tolerance = 0.0;
+    const auto result = GraphAlgorithms::pageRank(frozen, options);
+    EXPECT_EQ(result.iterations, 1u);
+    EXPECT_FALSE(result.converged);
+    EXPECT_GT(result.residual, 0.0);
+}
+
+TEST(PageRankTesting, RejectsGraphsWithoutInEdges) {
+    const auto graph = directedGraph(3, {{0, 1}, {1, 2}});
+    EXPECT_THROW(GraphAlgorithms::pageRank(graph.freeze()), std::runtime_error);
+    GraphAlgorithms::PageRankOptions options;
+    options.damping = 1.0;
+    EXPECT_THROW(GraphAlgorithms::pageRank(graph.freeze(true), options), std::runtime_error);
+}
+
+TEST(PageRankTesting, EmptyGraphConverges) {
+    const auto result = GraphAlgorithms::pageRank(DerivedGraph<int, int>(UDG).freeze(true));
+    EXPECT_TRUE(result.converged);
+    EXPECT_TRUE(result.scores.empty());
+}
+
+TEST(PageRankTesting, MappedGraphMatchesFrozenGraph) {
+    const auto graph = directedGraph(50, randomEdges(50, 300, 45, 11));
+    const std::string path = ::testing::TempDir() + "pagerank.uag";
+    writeGraphFile(graph, path, true);
+    const auto frozen = graph.freeze(true);
+    {
+        MappedCSRGraph<int, int> mapped(path);
+        const auto expected = GraphAlgorithms::pageRank(frozen);
+        const auto result = GraphAlgorithms::pageRank(mapped);
+        ASSERT_EQ(result.iterations, expected.iterations);
+        for (std::uint32_t id = 0; id < frozen.idBound(); id++) {
+            EXPECT_DOUBLE_EQ(result.scores[mapped.idOf(frozen.vertexOf(id))], expected.scores[id]);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(PageRankTesting, KatzOnAPathHasClosedForm) {
+    // Along 0 -> 1 -> 2 -> 3 vertex k collects beta (1 + alpha + ... + alpha^k)
+    const auto frozen = directedGraph(4, {{0, 1}, {1, 2}, {2, 3}}).freeze(true);
+    GraphAlgorithms::KatzOptions options;
+    options.alpha = 0.5;
+    options.beta = 2.0;
+    options.tolerance = 1e-12;
+    const auto result = GraphAlgorithms::katzCentrality(frozen, options);
+    ASSERT_TRUE(result.converged);
+    double expected = 0.0;
+    for (int k = 0; k < 4; k++) {
+        expected += options.beta * std::pow(options.alpha, k);
+        EXPECT_NEAR(result.scores[frozen.idOf(k)], expected, 1e-12);
+    }
+}
@@ -0,0 +1,109 @@
+// Created by Aaron H on 5/28/24.
+#include "../Algorithms/Parallel/ParallelFor.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    TEST(ParallelForTesting, EveryIndexRunsOnceAcrossRepeatedCalls) {
+        // Many small calls in a row, as BFS levels and PageRank iterations make them, reuse the same workers
+        const std::size_t size = 5000;
+        std::vector<std::atomic<int>> hits(size);
+        for (unsigned threads : {1u, 2u, 4u, 7u}) {
+            for (int round = 0; round < 200; round++) {
+                std::atomic<bool> indexInRange{true};
+                Parallel::parallelFor(0, size, 37, threads, [&](unsigned thread, std::size_t begin, std::size_t end) {
+                    if (thread >= threads) indexInRange = false;
+                    for (std::size_t index = begin; index < end; index++) hits[index].fetch_add(1, std::memory_order_relaxed);
+                });
+                ASSERT_TRUE(indexInRange);
+            }
+        }
+        for (const auto& count : hits) {
+            ASSERT_EQ(count.load(), 4 * 200);
+        }
+    }
+
+    TEST(ParallelForTesting, WritesAreVisibleAfterReturn) {
+        std::vector<std::size_t> values(100000, 0);
+        for (int round = 1; round <= 50; round++) {
+            Parallel::parallelFor(0, values.size(), 1024, 4, [&](unsigned, std::size_t begin, std::size_t end) {
+                for (std::size_t index = begin; index < end; index++) values[index] = index * round;
+            });
+            for (std::size_t index = 0; index < values.size(); index += 997) {
+                ASSERT_EQ(values[index], index * round);
+            }
+        }
+    }
+
+    TEST(ParallelForTesting, NestedCallsRunOnTheirCallingThread) {
+        std::atomic<std::size_t> total{0};
+        Parallel::parallelFor(0, 8, 1, 4, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t outer = begin; outer < end; outer++) {
+                const auto caller = std::this_thread::get_id();
+                Parallel::parallelFor(0, 100, 1, 4, [&](unsigned thread, std::size_t innerBegin, std::size_t innerEnd) {
+                    EXPECT_EQ(thread, 0u);
+                    EXPECT_EQ(std::this_thread::get_id(), caller);
+                    total.fetch_add(innerEnd - innerBegin, std::memory_order_relaxed);
+                });
+            }
+        });
+        EXPECT_EQ(total.load(), 800u);
+    }
+
+    TEST(ParallelForTesting, ExceptionsReachTheCaller) {
+        EXPECT_THROW(Parallel::parallelFor(0, 64, 1, 4, [](unsigned, std::size_t begin, std::size_t) {
+            if (begin == 40) throw std::runtime_error("chunk 40");
+        }), std::runtime_error);
+        // The pool stays usable afterwards
+        std::atomic<std::size_t> total{0};
+        Parallel::parallelFor(0, 64, 1, 4, [&](unsigned, std::size_t begin, std::size_t end) { total += end - begin; });
+        EXPECT_EQ(total.load(), 64u);
+
+        // While another caller holds the pool, the call runs on temporary threads and must rethrow just the same, both
+        // from its own thread and from the others
+        std::atomic<bool> occupied{false};
+        std::atomic<bool> released{false};
+        std::thread holder([&] {
+            Parallel::parallelFor(0, 2, 1, 2, [&](unsigned, std::size_t, std::size_t) {
+                occupied = true;
+                while (!released) std::this_thread::yield();
+            });
+        });
+        while (!occupied) std::this_thread::yield();
+        EXPECT_THROW(Parallel::parallelFor(0, 64, 1, 4, [](unsigned, std::size_t, std::size_t) {
+            throw std::runtime_error("every chunk");
+        }), std::runtime_error);
+        std::atomic<bool> thrown{false};
+        EXPECT_THROW(Parallel::parallelFor(0, 64, 1, 4, [&](unsigned thread, std::size_t, std::size_t) {
+            if (thread != 0) {
+                thrown = true;
+                throw std::runtime_error("other threads");
+            }
+            while (!thrown) std::this_thread::yield();  // Leaves the remaining chunks to the other threads
+        }), std::runtime_error);
+        released = true;
+        holder.join();
+    }
+
+    TEST(ParallelForTesting, ConcurrentCallersBothFinish) {
+        std::atomic<std::size_t> totals[2] = {{0}, {0}};
+        std::vector<std::thread> callers;
+        for (int caller = 0; caller < 2; caller++) {
+            callers.emplace_back([&totals, caller] {
+                for (int round = 0; round < 100; round++) {
+                    Parallel::parallelFor(0, 1000, 10, 3, [&](unsigned, std::size_t begin, std::size_t end) {
+                        totals[caller].fetch_add(end - begin, std::memory_order_relaxed);
+                    });
+                }
+            });
+        }
+        for (auto& caller : callers) caller.join();
+        EXPECT_EQ(totals[0].load(), 100000u);
+        EXPECT_EQ(totals[1].load(), 100000u);
+    }
+
+}  // namespace
@@ -0,0 +1,148 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/GraphAlgorithms/ShortestPaths.hpp"
+#include <gtest/gtest.h>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+namespace {
+
+    using GraphAlgorithms::DijkstraEngine;
+
+    DerivedGraph<int, int> randomGraph(int vertices, int edges, int maxWeight, unsigned seed) {
+        std::mt19937 rng(seed);
+        DerivedGraph<int, int> graph(UDG);
+        for (int i = 0; i < vertices; i++) graph.addVertex(i);
+        for (int i = 0; i < edges; i++) {
+            int source = rng() % vertices, destination = rng() % vertices;
+            if (!graph.hasEdge(source, destination)) graph.addEdge(source, destination, static_cast<int>(rng() % (maxWeight + 1)), false);
+        }
+        return graph;
+    }
+
+    // Textbook lazy-deletion Dijkstra on std::priority_queue
+    std::vector<long> referenceDistances(const DerivedGraph<int, int>& graph, std::uint32_t source) {
+        std::vector<long> distance(graph.idBound(), -1);
+        using Entry = std::pair<long, std::uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        queue.push({0, source});
+        while (!queue.empty()) {
+            auto [length, vertex] = queue.top();
+            queue.pop();
+            if (distance[vertex] != -1) continue;
+            distance[vertex] = length;
+            for (const auto& edge : graph.adjacentIds(vertex)) {
+                if (distance[edge.first] == -1) queue.push({length + edge.second, edge.first});
+            }
+        }
+        return distance;
+    }
+
+    template <template <typename> class Heap, typename GraphType>
+    void expectMatchesReference(const GraphType& graph, const std::vector<long>& expected, std::uint32_t source) {
+        auto tree = GraphAlgorithms::dijkstra<Heap>(graph, graph.vertexOf(source));
+        for (std::uint32_t vertex = 0; vertex < graph.idBound(); vertex++) {
+            if (expected[vertex] == -1) {
+                ASSERT_EQ(tree.parent[vertex], tree.unreached);
+                continue;
+            }
+            ASSERT_EQ(tree.distance[vertex], expected[vertex]);
+            if (vertex == source) {
+                ASSERT_EQ(tree.parent[vertex], source);
+                continue;
+            }
+            // The parent edge must be tight
+            std::uint32_t parent = tree.parent[vertex];
+            bool tight = false;
+            for (const auto& edge : graph.adjacentIds(parent)) {
+                tight = tight || (edge.first == vertex && tree.distance[parent] + edge.second == tree.distance[vertex]);
+            }
+            ASSERT_TRUE(tight);
+        }
+    }
+
+    TEST(ShortestPathsTest, SmallGraphPath) {
+        DerivedGraph<std::string, double> graph(DAG);
+        for (const char* name : {"a", "b", "c", "d", "e"}) graph.addVertex(name);
+        graph.addEdge("a", "b", 4.0, true);
+        graph.addEdge("a", "c", 1.0, true);
+        graph.addEdge("c", "b", 2.0, true);
+        graph.addEdge("b", "d", 1.0, true);
+        graph.addEdge("c", "d", 5.0, true);
+        auto path = GraphAlgorithms::shortestPath(graph, "a", "d");
+        ASSERT_TRUE(path.found);
+        ASSERT_DOUBLE_EQ(path.length, 4.0);
+        ASSERT_EQ(path.vertices, (std::vector<std::string>{"a", "c", "b", "d"}));
+
+        auto unreachable = GraphAlgorithms::shortestPath<PairingHeap>(graph, "a", "e");
+        ASSERT_FALSE(unreachable.found);
+        ASSERT_TRUE(unreachable.vertices.empty());
+        auto trivial = GraphAlgorithms::shortestPath(graph, "e", "e");
+        ASSERT_TRUE(trivial.found);
+        ASSERT_EQ(trivial.vertices, std::vector<std::string>{"e"});
+    }
+
+    TEST(ShortestPathsTest, HeapsMatchReference) {
+        for (int maxWeight : {0, 3, 1000000}) {
+            DerivedGraph<int, int> graph = randomGraph(3000, 15000, maxWeight, 11 + maxWeight);
+            auto expected = referenceDistances(graph, 0);
+            expectMatchesReference<DaryHeap>(graph, expected, 0);
+            expectMatchesReference<PairingHeap>(graph, expected, 0);
+            expectMatchesReference<RadixHeap>(graph, expected, 0);
+        }
+    }
+
+    TEST(ShortestPathsTest, FrozenGraphMatchesDerived) {
+        DerivedGraph<int, int> graph = randomGraph(2000, 10000, 50, 5);
+        CSRGraph<int, int> frozen = graph.freeze();
+        for (int source : {0, 17, 1999}) {
+            auto expected = GraphAlgorithms::dijkstra(graph, source);
+            auto actual = GraphAlgorithms::dijkstra<RadixHeap>(frozen, source);
+            for (int vertex = 0; vertex < 2000; vertex++) {
+                ASSERT_EQ(expected.parent[graph.idOf(vertex)] == expected.unreached, actual.parent[frozen.idOf(vertex)] == actual.unreached);
+                ASSERT_EQ(expected.distance[graph.idOf(vertex)], actual.distance[frozen.idOf(vertex)]);
+            }
+        }
+    }
+
+    TEST(ShortestPathsTest, EngineReuseWithEarlyStop) {
+        DerivedGraph<int, int> graph = randomGraph(2000, 8000, 100, 3);
+        DijkstraEngine<DerivedGraph<int, int>, PairingHeap> engine(graph);
+        std::mt19937 rng(9);
+        for (int query = 0; query < 200; query++) {
+            std::uint32_t source = rng() % 2000, target = rng() % 2000;
+            auto expected = referenceDistances(graph, source);
+            ASSERT_EQ(engine.run(source, target), expected[target] != -1);
+            if (expected[target] == -1) {
+                ASSERT_TRUE(engine.pathTo(target).empty());
+                continue;
+            }
+            ASSERT_EQ(engine.distance(target), expected[target]);
+            auto path = engine.pathTo(target);
+            ASSERT_EQ(path.front(), source);
+            ASSERT_EQ(path.back(), target);
+        }
+    }
+
+    TEST(ShortestPathsTest, RejectsNegativeWeights) {
+        DerivedGraph<int, int> graph(DAG);
+        for (int i = 1; i <= 3; i++) graph.addVertex(i);
+        graph.addEdge(1, 2, 5, true);
+        graph.addEdge(2, 3, -3, true);
+        ASSERT_EQ(graph.stats().negativeWeightEdges, 1);
+        ASSERT_THROW(GraphAlgorithms::dijkstra(graph, 1), std::runtime_error);
+        ASSERT_THROW(GraphAlgorithms::dijkstra(graph.freeze(), 1), std::runtime_error);
+
+        graph.removeEdge(2, 3);
+        ASSERT_EQ(graph.stats().negativeWeightEdges, 0);
+        ASSERT_EQ(GraphAlgorithms::dijkstra(graph, 1).distance[graph.idOf(2)], 5);
+
+        graph.addEdge(3, 1, -1, true);
+        graph.removeVertex(3);
+        ASSERT_EQ(graph.stats().negativeWeightEdges, 0);
+        auto built = DerivedGraph<int, int>::from_edges({{1, 2, -1}, {2, 3, 4}}, DAG);
+        ASSERT_EQ(built.stats().negativeWeightEdges, 1);
+    }
+
+}  // namespace
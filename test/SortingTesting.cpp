@@ -0,0 +1,182 @@
+// Created by Aaron H on 5/28/24.
+#include "../Algorithms/Sorting/PdqSort.hpp"
+#include "../Algorithms/Sorting/RadixSort.hpp"
+#include "../Algorithms/Sorting/SampleSort.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+namespace {
+
+    enum Pattern { Random, Sorted, Reversed, FewDistinct, OrganPipe, SortedTail };
+
+    std::vector<std::uint64_t> makeKeys(Pattern pattern, std::size_t size, unsigned seed = 7) {
+        std::mt19937_64 rng(seed);
+        std::vector<std::uint64_t> keys(size);
+        for (auto& key : keys) key = rng();
+        switch (pattern) {
+            case Random:
+                break;
+            case Sorted:
+                std::sort(keys.begin(), keys.end());
+                break;
+            case Reversed:
+                std::sort(keys.begin(), keys.end(), std::greater<>());
+                break;
+            case FewDistinct:
+                for (auto& key : keys) key %= 4;
+                break;
+            case OrganPipe:
+                for (std::size_t i = 0; i < size; i++) keys[i] = std::min(i, size - i);
+                break;
+            case SortedTail:
+                // Sorted but for a few random elements appended
+                std::sort(keys.begin(), keys.end());
+                for (std::size_t i = size - std::min<std::size_t>(size, 5); i < size; i++) keys[i] = rng();
+                break;
+        }
+        return keys;
+    }
+
+    const Pattern patterns[] = {Random, Sorted, Reversed, FewDistinct, OrganPipe, SortedTail};
+    const std::size_t sizes[] = {0, 1, 2, 23, 24, 100, 1000, 100000};
+
+    struct Record {
+        std::uint32_t source = 0;
+        std::uint32_t destination = 0;
+        int weight = 0;  // Insertion order, to check stability
+    };
+
+    std::uint64_t recordKey(const Record& record) {
+        return static_cast<std::uint64_t>(record.source) << 32 | record.destination;
+    }
+
+    std::vector<Record> makeRecords(std::size_t size, std::uint32_t vertices) {
+        std::mt19937 rng(3);
+        std::vector<Record> records(size);
+        for (std::size_t i = 0; i < size; i++) {
+            records[i] = {static_cast<std::uint32_t>(rng() % vertices), static_cast<std::uint32_t>(rng() % vertices), static_cast<int>(i)};
+        }
+        return records;
+    }
+
+}
+
+TEST(SortingTesting, PdqsortMatchesStdSort) {
+    for (Pattern pattern : patterns) {
+        for (std::size_t size : sizes) {
+            auto keys = makeKeys(pattern, size);
+            auto expected = keys;
+            std::sort(expected.begin(), expected.end());
+            Sorting::pdqsort(keys.begin(), keys.end());
+            EXPECT_EQ(keys, expected) << "pattern " << pattern << ", size " << size;
+        }
+    }
+}
+
+TEST(SortingTesting, PdqsortTakesComparatorsAndNonArithmeticValues) {
+    auto keys = makeKeys(Random, 5000);
+    Sorting::pdqsort(keys.begin(), keys.end(), std::greater<>());
+    EXPECT_TRUE(std::is_sorted(keys.begin(), keys.end(), std::greater<>()));
+
+    auto branchless = makeKeys(FewDistinct, 5000);
+    Sorting::pdqsortBranchless(branchless.begin(), branchless.end(), [](std::uint64_t a, std::uint64_t b) { return a < b; });
+    EXPECT_TRUE(std::is_sorted(branchless.begin(), branchless.end()));
+
+    std::vector<std::string> words;
+    std::mt19937 rng(11);
+    for (int i = 0; i < 3000; i++) words.push_back(std::to_string(rng() % 500));
+    auto expected = words;
+    std::sort(expected.begin(), expected.end());
+    Sorting::pdqsort(words.begin(), words.end());
+    EXPECT_EQ(words, expected);
+}
+
+TEST(SortingTesting, PdqsortSurvivesAdversarialPivots) {
+    // Median-of-three killer: pushes quicksort towards quadratic time unless pivots are shuffled
+    const std::size_t size = 1 << 16;
+    std::vector<std::uint32_t> keys(size);
+    for (std::size_t i = 0; i < size / 2; i++) {
+        keys[i] = static_cast<std::uint32_t>(i % 2 == 0 ? i + 1 : size / 2 + i);
+        keys[size / 2 + i] = static_cast<std::uint32_t>(2 * (i + 1));
+    }
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+    Sorting::pdqsort(keys.begin(), keys.end());
+    EXPECT_EQ(keys, expected);
+}
+
+TEST(SortingTesting, RadixSortsMatchStdSort) {
+    for (Pattern pattern : patterns) {
+        for (std::size_t size : sizes) {
+            auto expected = makeKeys(pattern, size);
+            std::sort(expected.begin(), expected.end());
+            auto lsd = makeKeys(pattern, size);
+            Sorting::radixSort(lsd.begin(), lsd.end());
+            EXPECT_EQ(lsd, expected) << "pattern " << pattern << ", size " << size;
+            auto msd = makeKeys(pattern, size);
+            Sorting::inPlaceRadixSort(msd.begin(), msd.end());
+            EXPECT_EQ(msd, expected) << "pattern " << pattern << ", size " << size;
+        }
+    }
+}
+
+TEST(SortingTesting, RadixSortHandlesNarrowKeys) {
+    std::vector<std::uint8_t> bytes(1000);
+    std::mt19937 rng(5);
+    for (auto& value : bytes) value = static_cast<std::uint8_t>(rng());
+    auto expected = bytes;
+    std::sort(expected.begin(), expected.end());
+    auto lsd = bytes;
+    Sorting::radixSort(lsd.begin(), lsd.end());
+    EXPECT_EQ(lsd, expected);
+    Sorting::inPlaceRadixSort(bytes.begin(), bytes.end());
+    EXPECT_EQ(bytes, expected);
+}
+
+TEST(SortingTesting, RadixSortIsStableOnRecords) {
+    for (std::size_t size : {std::size_t{50}, std::size_t{20000}}) {
+        auto records = makeRecords(size, 16);
+        Sorting::radixSort(records.begin(), records.end(), recordKey);
+        for (std::size_t i = 1; i < records.size(); i++) {
+            ASSERT_LE(recordKey(records[i - 1]), recordKey(records[i]));
+            if (recordKey(records[i - 1]) == recordKey(records[i])) {
+                ASSERT_LT(records[i - 1].weight, records[i].weight);
+            }
+        }
+    }
+}
+
+TEST(SortingTesting, InPlaceRadixSortKeepsEveryRecord) {
+    auto records = makeRecords(30000, 1000);
+    Sorting::inPlaceRadixSort(records.begin(), records.end(), recordKey);
+    EXPECT_TRUE(std::is_sorted(records.begin(), records.end(), [](const Record& a, const Record& b) { return recordKey(a) < recordKey(b); }));
+    std::vector<bool> seen(records.size(), false);
+    for (const Record& record : records) seen[record.weight] = true;
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](bool value) { return value; }));
+}
+
+TEST(SortingTesting, SampleSortMatchesStdSort) {
+    // Four threads even on one core: the result must not depend on scheduling
+    for (Pattern pattern : patterns) {
+        for (std::size_t size : {std::size_t{1000}, Sorting::parallelSortThreshold, std::size_t{300000}}) {
+            auto keys = makeKeys(pattern, size);
+            auto expected = keys;
+            std::sort(expected.begin(), expected.end());
+            Sorting::sampleSort(keys.begin(), keys.end(), std::less<>(), 4);
+            EXPECT_EQ(keys, expected) << "pattern " << pattern << ", size " << size;
+        }
+    }
+}
+
+TEST(SortingTesting, SampleSortOrdersRecordsByComparator) {
+    auto records = makeRecords(200000, 1 << 12);
+    auto byKey = [](const Record& a, const Record& b) { return recordKey(a) < recordKey(b); };
+    Sorting::sampleSort(records.begin(), records.end(), byKey, 3);
+    EXPECT_TRUE(std::is_sorted(records.begin(), records.end(), byKey));
+    std::vector<bool> seen(records.size(), false);
+    for (const Record& record : records) seen[record.weight] = true;
+    EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](bool value) { return value; }));
+}
@@ -0,0 +1,116 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/GraphAlgorithms/TopologicalSort.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+namespace {
+
+    using GraphAlgorithms::TopologicalMethod;
+
+    DerivedGraph<int, int> randomDag(int vertices, int edges, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::tuple<int, int, int>> list;
+        for (int i = 0; i < edges; i++) {
+            int a = rng() % vertices, b = rng() % vertices;
+            if (a != b) list.emplace_back(std::min(a, b), std::max(a, b), 1);
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        // Relabel so the topological order is not simply ascending
+        std::vector<int> label(vertices);
+        for (int i = 0; i < vertices; i++) label[i] = i;
+        std::shuffle(label.begin(), label.end(), rng);
+        for (auto& edge : list) edge = {label[std::get<0>(edge)], label[std::get<1>(edge)], 1};
+        return DerivedGraph<int, int>::from_edges(list, DAG);
+    }
+
+    template <typename GraphType>
+    void expectTopological(const GraphType& graph, const std::vector<std::uint32_t>& order) {
+        std::vector<std::size_t> position(graph.idBound(), order.size());
+        for (std::size_t i = 0; i < order.size(); i++) position[order[i]] = i;
+        std::size_t live = 0;
+        for (std::uint32_t vertex = 0; vertex < graph.idBound(); vertex++) {
+            if (!graph.containsId(vertex)) continue;
+            live++;
+            ASSERT_LT(position[vertex], order.size());
+            for (std::size_t index = 0; index < graph.outDegree(vertex); index++) {
+                ASSERT_LT(position[vertex], position[graph.neighborAt(vertex, index)]);
+            }
+        }
+        ASSERT_EQ(order.size(), live);
+    }
+
+    TEST(TopologicalSortTest, BothMethodsOrderEveryEdgeForward) {
+        DerivedGraph<int, int> graph = randomDag(3000, 12000, 1);
+        for (TopologicalMethod method : {TopologicalMethod::Kahn, TopologicalMethod::DepthFirst}) {
+            expectTopological(graph, GraphAlgorithms::topologicalOrderIds(graph, method));
+            expectTopological(graph.freeze(), GraphAlgorithms::topologicalOrderIds(graph.freeze(), method));
+        }
+    }
+
+    TEST(TopologicalSortTest, VerticesAndRecycledIds) {
+        DerivedGraph<std::string, int> graph(DAG);
+        for (const char* name : {"compile", "link", "test", "package", "scratch"}) graph.addVertex(name);
+        graph.addEdge("compile", "link", 1, true);
+        graph.addEdge("link", "test", 1, true);
+        graph.addEdge("link", "package", 1, true);
+        graph.removeVertex("scratch");
+        graph.addVertex("fetch");
+        graph.addEdge("fetch", "compile", 1, true);
+        auto order = GraphAlgorithms::topologicalSort(graph);
+        ASSERT_EQ(order.size(), 5);
+        ASSERT_EQ(order[0], "fetch");
+        ASSERT_EQ(order[1], "compile");
+        ASSERT_EQ(order[2], "link");
+        auto depthFirst = GraphAlgorithms::topologicalSort(graph, TopologicalMethod::DepthFirst);
+        ASSERT_EQ(depthFirst.front(), "fetch");
+    }
+
+    TEST(TopologicalSortTest, CyclesThrow) {
+        DerivedGraph<int, int> graph(UDG);
+        for (int i = 0; i < 3; i++) graph.addVertex(i);
+        graph.addEdge(0, 1, 1, false);
+        graph.addEdge(1, 2, 1, false);
+        graph.addEdge(2, 1, 1, false);
+        ASSERT_THROW(GraphAlgorithms::topologicalSort(graph), std::runtime_error);
+        ASSERT_THROW(GraphAlgorithms::topologicalSort(graph, TopologicalMethod::DepthFirst), std::runtime_error);
+        ASSERT_THROW(GraphAlgorithms::levelize(graph, 2), std::runtime_error);
+    }
+
+    TEST(TopologicalSortTest, LevelsFollowLongestPath) {
+        DerivedGraph<int, int> graph = randomDag(5000, 20000, 2);
+        std::vector<std::uint32_t> order = GraphAlgorithms::topologicalOrderIds(graph);
+        // Reference levels by dynamic programming over a topological order
+        std::vector<std::uint32_t> expected(graph.idBound(), 0);
+        for (std::uint32_t vertex : order) {
+            for (std::size_t index = 0; index < graph.outDegree(vertex); index++) {
+                std::uint32_t next = graph.neighborAt(vertex, index);
+                expected[next] = std::max(expected[next], expected[vertex] + 1);
+            }
+        }
+        auto sequential = GraphAlgorithms::levelize(graph, 1);
+        for (std::uint32_t vertex = 0; vertex < graph.idBound(); vertex++) {
+            ASSERT_EQ(sequential.levelOf[vertex], expected[vertex]);
+        }
+        expectTopological(graph, sequential.vertices);
+        std::size_t total = 0;
+        for (std::size_t level = 0; level < sequential.numLevels(); level++) {
+            ASSERT_GT(sequential.levelSize(level), 0);
+            ASSERT_TRUE(std::is_sorted(sequential.levelBegin(level), sequential.levelEnd(level)));
+            total += sequential.levelSize(level);
+        }
+        ASSERT_EQ(total, graph.numVertices());
+
+        auto parallel = GraphAlgorithms::levelize(graph.freeze(), 4);
+        ASSERT_EQ(parallel.numLevels(), sequential.numLevels());
+        ASSERT_EQ(parallel.offsets, sequential.offsets);
+    }
+
+    TEST(TopologicalSortTest, EmptyGraph) {
+        DerivedGraph<int, int> graph(DAG);
+        ASSERT_TRUE(GraphAlgorithms::topologicalSort(graph).empty());
+        ASSERT_EQ(GraphAlgorithms::levelize(graph).numLevels(), 0);
+    }
+
+}  // namespace
@@ -0,0 +1,177 @@
+// Created by Aaron H on 5/28/24.
+#include "../Structures/ADT/Graph.hpp"
+#include "../Algorithms/GraphAlgorithms/SetIntersection.hpp"
+#include "../Algorithms/GraphAlgorithms/Triangles.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+namespace {
+
+    std::vector<std::uint32_t> randomSortedSet(std::mt19937& rng, std::size_t size, std::uint32_t range) {
+        std::set<std::uint32_t> values;
+        while (values.size() < size) values.insert(static_cast<std::uint32_t>(rng() % range));
+        return {values.begin(), values.end()};
+    }
+
+    std::vector<std::uint32_t> expectedIntersection(const std::vector<std::uint32_t>& a, const std::vector<std::uint32_t>& b) {
+        std::vector<std::uint32_t> common;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(common));
+        return common;
+    }
+
+    // Runs kernel on many random pairs, including lengths around the SIMD block sizes and very unequal lengths
+    template <typename Kernel>
+    void expectIntersections(Kernel kernel) {
+        std::mt19937 rng(17);
+        const std::size_t sizes[] = {0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33, 100, 1000};
+        for (std::size_t aSize : sizes) {
+            for (std::size_t bSize : sizes) {
+                for (std::uint32_t range : {64u, 4096u}) {
+                    if (aSize > range || bSize > range) continue;
+                    const auto a = randomSortedSet(rng, aSize, range);
+                    const auto b = randomSortedSet(rng, bSize, range);
+                    std::vector<std::uint32_t> visited;
+                    auto visit = [&visited](std::uint32_t id) { visited.push_back(id); };
+                    const std::size_t count = kernel(a.data(), a.size(), b.data(), b.size(), visit);
+                    const auto expected = expectedIntersection(a, b);
+                    ASSERT_EQ(count, expected.size()) << aSize << " x " << bSize << " in " << range;
+                    ASSERT_EQ(visited, expected) << aSize << " x " << bSize << " in " << range;
+                }
+            }
+        }
+    }
+
+    std::vector<std::tuple<int, int, int>> randomEdges(int vertices, int edges, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::tuple<int, int, int>> list;
+        for (int i = 0; i < edges; i++) {
+            const int a = static_cast<int>(rng() % vertices), b = static_cast<int>(rng() % vertices);
+            if (a != b) list.emplace_back(std::min(a, b), std::max(a, b), 1);
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        return list;
+    }
+
+    // Triangles through every vertex by brute force over an adjacency matrix
+    std::vector<std::uint64_t> bruteForceTriangles(int vertices, const std::vector<std::tuple<int, int, int>>& edges) {
+        std::vector<std::vector<bool>> adjacent(vertices, std::vector<bool>(vertices, false));
+        for (const auto& [a, b, weight] : edges) {
+            adjacent[a][b] = adjacent[b][a] = true;
+        }
+        std::vector<std::uint64_t> triangles(vertices, 0);
+        for (int a = 0; a < vertices; a++)
+            for (int b = a + 1; b < vertices; b++)
+                for (int c = b + 1; c < vertices; c++)
+                    if (adjacent[a][b] && adjacent[b][c] && adjacent[a][c]) {
+                        triangles[a]++;
+                        triangles[b]++;
+                        triangles[c]++;
+                    }
+        return triangles;
+    }
+
+}
+
+TEST(TrianglesTesting, IntersectionKernelsMatchStdSetIntersection) {
+    expectIntersections([](auto... args) { return GraphAlgorithms::intersectSorted(args...); });
+    expectIntersections([](const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, auto& visit) {
+        return GraphAlgorithms::IntersectionDetail::scalarIntersect(a, aSize, b, bSize, visit);
+    });
+    expectIntersections([](const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, auto& visit) {
+        return aSize <= bSize ? GraphAlgorithms::IntersectionDetail::gallopIntersect(a, aSize, b, bSize, visit)
+                              : GraphAlgorithms::IntersectionDetail::gallopIntersect(b, bSize, a, aSize, visit);
+    });
+#if defined(__SSE2__)
+    expectIntersections([](const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, auto& visit) {
+        return GraphAlgorithms::IntersectionDetail::sseIntersect(a, aSize, b, bSize, visit);
+    });
+#endif
+#if defined(__AVX2__)
+    expectIntersections([](const std::uint32_t* a, std::size_t aSize, const std::uint32_t* b, std::size_t bSize, auto& visit) {
+        return GraphAlgorithms::IntersectionDetail::avx2Intersect(a, aSize, b, bSize, visit);
+    });
+#endif
+}
+
+TEST(TrianglesTesting, CompleteGraphHasEveryTriangle) {
+    DerivedGraph<int, int> graph(UDG);
+    const int n = 12;
+    for (int i = 0; i < n; i++) graph.addVertex(i);
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++) graph.addEdge(i, j, 1, false);
+    EXPECT_EQ(GraphAlgorithms::countTriangles(graph), static_cast<std::uint64_t>(n * (n - 1) * (n - 2) / 6));
+    for (double coefficient : GraphAlgorithms::clusteringCoefficients(graph)) {
+        EXPECT_DOUBLE_EQ(coefficient, 1.0);
+    }
+}
+
+TEST(TrianglesTesting, DirectionsSelfLoopsAndReverseEdgesAreIgnored) {
+    // Triangle 1-2-3 stored with mixed directions, both directions of 1-2, a self-loop and a pendant vertex 4
+    DerivedGraph<int, int> graph(UDG);
+    for (int i = 1; i <= 4; i++) graph.addVertex(i);
+    graph.addDirectionalEdge(1, 2, 1, false);
+    graph.addEdge(3, 2, 1, false);
+    graph.addEdge(1, 3, 1, false);
+    graph.addEdge(3, 3, 1, false);
+    graph.addEdge(4, 3, 1, false);
+
+    EXPECT_EQ(GraphAlgorithms::countTriangles(graph), 1u);
+    const auto triangles = GraphAlgorithms::trianglesPerVertex(graph);
+    EXPECT_EQ(triangles[graph.idOf(1)], 1u);
+    EXPECT_EQ(triangles[graph.idOf(3)], 1u);
+    EXPECT_EQ(triangles[graph.idOf(4)], 0u);
+
+    const auto coefficients = GraphAlgorithms::clusteringCoefficients(graph);
+    EXPECT_DOUBLE_EQ(coefficients[graph.idOf(1)], 1.0);
+    EXPECT_DOUBLE_EQ(coefficients[graph.idOf(3)], 1.0 / 3.0);  // Neighbors 1, 2 and 4; only 1-2 are adjacent
+    EXPECT_DOUBLE_EQ(coefficients[graph.idOf(4)], 0.0);
+}
+
+TEST(TrianglesTesting, RandomGraphsMatchBruteForce) {
+    for (unsigned seed : {1u, 2u, 3u}) {
+        const int vertices = 120;
+        const auto edges = randomEdges(vertices, 1500, seed);
+        const auto expected = bruteForceTriangles(vertices, edges);
+        std::uint64_t expectedTotal = 0;
+        for (std::uint64_t count : expected) expectedTotal += count;
+        expectedTotal /= 3;
+
+        const auto graph = DerivedGraph<int, int>::from_edges(edges, UDG);
+        const auto frozen = graph.freeze();
+        std::vector<bool> present(vertices, false);  // from_edges only adds endpoints
+        for (const auto& [a, b, weight] : edges) present[a] = present[b] = true;
+        for (unsigned threads : {1u, 4u}) {
+            EXPECT_EQ(GraphAlgorithms::countTriangles(graph, threads), expectedTotal);
+            EXPECT_EQ(GraphAlgorithms::countTriangles(frozen, threads), expectedTotal);
+            const auto perVertex = GraphAlgorithms::trianglesPerVertex(graph, threads);
+            for (int v = 0; v < vertices; v++) {
+                if (present[v]) {
+                    ASSERT_EQ(perVertex[graph.idOf(v)], expected[v]) << "vertex " << v << ", seed " << seed;
+                }
+            }
+        }
+    }
+}
+
+TEST(TrianglesTesting, RemovedVerticesLeaveHoles) {
+    DerivedGraph<int, int> graph(UDG);
+    for (int i = 0; i < 5; i++) graph.addVertex(i);
+    for (int i = 0; i < 5; i++)
+        for (int j = i + 1; j < 5; j++) graph.addEdge(i, j, 1, false);
+    const auto removedId = graph.idOf(2);
+    graph.removeVertex(2);
+    EXPECT_EQ(GraphAlgorithms::countTriangles(graph), 4u);  // K4 remains
+    const auto coefficients = GraphAlgorithms::clusteringCoefficients(graph);
+    ASSERT_EQ(coefficients.size(), graph.idBound());
+    EXPECT_DOUBLE_EQ(coefficients[removedId], 0.0);
+    EXPECT_DOUBLE_EQ(coefficients[graph.idOf(4)], 1.0);
+
+    const auto view = GraphAlgorithms::degreeOrderedView(graph);
+    EXPECT_EQ(view.numVertices(), 4u);
+    EXPECT_EQ(view.numEdges(), 6u);
+    EXPECT_EQ(view.rankOf[removedId], GraphAlgorithms::DegreeOrderedView::none);
+}